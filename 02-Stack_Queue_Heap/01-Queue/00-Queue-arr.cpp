@@ -1,4 +1,13 @@
 #include <iostream>
+#include <queue>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
 using namespace std;
 
 // Queue implementation using an array
@@ -75,8 +84,251 @@ public:
     }
 };
 
+// Bounded lock-free multi-producer/multi-consumer ring queue (Vyukov).
+// Every slot carries a sequence number: seq == pos means the slot is free for
+// the enqueue at position pos, seq == pos + 1 means it holds that item. The
+// two position counters sit on their own cache lines so producers and
+// consumers do not invalidate each other's line.
+template <typename T>
+class MPMCQueue {
+private:
+    struct Slot {
+        atomic<size_t> seq;
+        T data;
+    };
+
+    Slot* buffer;
+    size_t mask;
+    alignas(64) atomic<size_t> enqueuePos{0};
+    alignas(64) atomic<size_t> dequeuePos{0};
+
+public:
+    // Capacity must be a power of two
+    MPMCQueue(size_t capacity) {
+        if (capacity < 2 || (capacity & (capacity - 1))) {
+            throw invalid_argument("MPMCQueue capacity must be a power of two >= 2.");
+        }
+        buffer = new Slot[capacity];
+        mask = capacity - 1;
+        for (size_t i = 0; i < capacity; i++) buffer[i].seq.store(i, memory_order_relaxed);
+    }
+
+    ~MPMCQueue() {
+        delete[] buffer;
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    // Returns false if the queue is full
+    bool enqueue(const T& item) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &buffer[pos & mask];
+            size_t seq = slot->seq.load(memory_order_acquire);
+            intptr_t dif = intptr_t(seq) - intptr_t(pos);
+            if (dif == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+        slot->data = item;
+        slot->seq.store(pos + 1, memory_order_release);
+        return true;
+    }
+
+    // Returns false if the queue is empty
+    bool dequeue(T& item) {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &buffer[pos & mask];
+            size_t seq = slot->seq.load(memory_order_acquire);
+            intptr_t dif = intptr_t(seq) - intptr_t(pos + 1);
+            if (dif == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+        item = move(slot->data);
+        slot->seq.store(pos + mask + 1, memory_order_release);
+        return true;
+    }
+
+    // Enqueues up to `count` items with a single CAS on the position counter:
+    // claims the run of consecutive free slots starting at the tail.
+    // Returns how many were enqueued (0 if the queue is full).
+    size_t enqueue_bulk(const T* items, size_t count) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        size_t n;
+        while (true) {
+            n = 0;
+            while (n < count && buffer[(pos + n) & mask].seq.load(memory_order_acquire) == pos + n) n++;
+            if (n == 0) {
+                size_t seq = buffer[pos & mask].seq.load(memory_order_acquire);
+                if (intptr_t(seq) - intptr_t(pos) < 0) return 0;
+                pos = enqueuePos.load(memory_order_relaxed);
+                continue;
+            }
+            if (enqueuePos.compare_exchange_weak(pos, pos + n, memory_order_relaxed)) break;
+        }
+        for (size_t i = 0; i < n; i++) {
+            Slot& slot = buffer[(pos + i) & mask];
+            slot.data = items[i];
+            slot.seq.store(pos + i + 1, memory_order_release);
+        }
+        return n;
+    }
+
+    // Dequeues up to `count` items into `out`; returns how many were taken.
+    size_t dequeue_bulk(T* out, size_t count) {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        size_t n;
+        while (true) {
+            n = 0;
+            while (n < count && buffer[(pos + n) & mask].seq.load(memory_order_acquire) == pos + n + 1) n++;
+            if (n == 0) {
+                size_t seq = buffer[pos & mask].seq.load(memory_order_acquire);
+                if (intptr_t(seq) - intptr_t(pos + 1) < 0) return 0;
+                pos = dequeuePos.load(memory_order_relaxed);
+                continue;
+            }
+            if (dequeuePos.compare_exchange_weak(pos, pos + n, memory_order_relaxed)) break;
+        }
+        for (size_t i = 0; i < n; i++) {
+            Slot& slot = buffer[(pos + i) & mask];
+            out[i] = move(slot.data);
+            slot.seq.store(pos + i + mask + 1, memory_order_release);
+        }
+        return n;
+    }
+
+    size_t capacity() const {
+        return mask + 1;
+    }
+
+    // Approximate while other threads are running
+    size_t size() const {
+        size_t tail = enqueuePos.load(memory_order_acquire), head = dequeuePos.load(memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+};
+
+// Baseline: std::queue behind one mutex, bounded to the same capacity
+template <typename T>
+class LockedQueue {
+private:
+    queue<T> items;
+    mutex mtx;
+    size_t limit;
+
+public:
+    LockedQueue(size_t capacity) : limit(capacity) {}
+
+    bool enqueue(const T& item) {
+        lock_guard<mutex> lock(mtx);
+        if (items.size() == limit) return false;
+        items.push(item);
+        return true;
+    }
+
+    bool dequeue(T& item) {
+        lock_guard<mutex> lock(mtx);
+        if (items.empty()) return false;
+        item = items.front();
+        items.pop();
+        return true;
+    }
+
+    size_t enqueue_bulk(const T* in, size_t count) {
+        lock_guard<mutex> lock(mtx);
+        size_t n = min(count, limit - items.size());
+        for (size_t i = 0; i < n; i++) items.push(in[i]);
+        return n;
+    }
+
+    size_t dequeue_bulk(T* out, size_t count) {
+        lock_guard<mutex> lock(mtx);
+        size_t n = min(count, items.size());
+        for (size_t i = 0; i < n; i++) {
+            out[i] = items.front();
+            items.pop();
+        }
+        return n;
+    }
+};
+
+// Producer/consumer throughput: each producer pushes `perProducer` values,
+// consumers drain until all have been seen; the sum checks nothing was lost.
+// batch == 0 uses the single-item calls.
+template <typename Q>
+double runPipeline(Q& q, int producers, int consumers, size_t perProducer, size_t batch) {
+    atomic<uint64_t> consumed{0}, checksum{0};
+    uint64_t total = uint64_t(producers) * perProducer;
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            vector<uint64_t> items(batch ? batch : 1);
+            for (size_t i = 0; i < perProducer;) {
+                size_t k = batch ? min(batch, perProducer - i) : 1;
+                for (size_t j = 0; j < k; j++) items[j] = uint64_t(p) * perProducer + i + j + 1;
+                size_t sent = batch ? q.enqueue_bulk(items.data(), k) : size_t(q.enqueue(items[0]));
+                if (sent == 0) this_thread::yield();
+                // A partial bulk enqueue retries the rest on the next round
+                i += sent;
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&] {
+            vector<uint64_t> items(batch ? batch : 1);
+            uint64_t sum = 0;
+            while (consumed.load(memory_order_relaxed) < total) {
+                size_t got = batch ? q.dequeue_bulk(items.data(), batch) : size_t(q.dequeue(items[0]));
+                if (got == 0) {
+                    this_thread::yield();
+                    continue;
+                }
+                for (size_t j = 0; j < got; j++) sum += items[j];
+                consumed.fetch_add(got, memory_order_relaxed);
+            }
+            checksum.fetch_add(sum);
+        });
+    }
+    for (auto& t : threads) t.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    if (checksum.load() != total * (total + 1) / 2) cout << "  CHECKSUM MISMATCH\n";
+    return total / seconds / 1e6;
+}
+
+// totalItems is split evenly across the producers of each configuration
+void benchmark(size_t totalItems) {
+    cout << "\n--- MPMC benchmark (M items/s, capacity 1024, "
+         << thread::hardware_concurrency() << " hardware threads) ---\n";
+    cout << "producers x consumers | mutex std::queue | MPMC | mutex bulk(32) | MPMC bulk(32)\n";
+    for (int threads : {1, 2, 4, 8}) {
+        LockedQueue<uint64_t> locked(1024), lockedBulk(1024);
+        MPMCQueue<uint64_t> single(1024), bulk(1024);
+        size_t n = totalItems / threads;
+        double a = runPipeline(locked, threads, threads, n, 0);
+        double b = runPipeline(single, threads, threads, n, 0);
+        double c = runPipeline(lockedBulk, threads, threads, n, 32);
+        double d = runPipeline(bulk, threads, threads, n, 32);
+        cout << "  " << threads << " x " << threads << "                | " << a << " | " << b << " | " << c << " | "
+             << d << "\n";
+    }
+}
+
 // Demonstration of Queue operations
-int main() {
+int main(int argc, char** argv) {
     Queue q(5); // Create a queue of size 5
 
     q.enqueue(10);
@@ -94,6 +346,10 @@ int main() {
     q.dequeue();
     q.dequeue();
     q.dequeue(); // Should indicate queue is empty
-    
+
+    // Usage: 00-Queue-arr --benchmark [items]
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        benchmark(argc > 2 ? stoull(argv[2]) : 4000000);
+    }
     return 0;
 }
@@ -1,5 +1,15 @@
 #include <iostream>
+#include <fstream>
+#include <iomanip>
 #include <string>
+#include <vector>
+#include <deque>
+#include <queue>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
 #include <stdexcept>
 
 using namespace std;
@@ -77,6 +87,15 @@ public:
         return currentSize;
     }
 
+    // Copy of the queued processes, front to rear
+    vector<Process> snapshot() const {
+        vector<Process> out;
+        for (int count = 0, index = front; count < currentSize; count++, index = (index + 1) % MAX_SIZE) {
+            out.push_back(*queue[index]);
+        }
+        return out;
+    }
+
     // Display the current state of the queue
     void display() const {
         if (isEmpty()) {
@@ -95,6 +114,333 @@ public:
     }
 };
 
+// ---------------- Discrete-event simulation ----------------
+
+// One entry of a replayable trace; the job id is its index in the trace
+struct TraceJob {
+    int64_t arrivalTime;
+    int32_t burstTime;
+};
+
+// Pluggable ready-queue policy driven by the simulator
+class SchedulingPolicy {
+public:
+    virtual ~SchedulingPolicy() = default;
+    virtual string name() const = 0;
+    virtual void reset(size_t /*jobCount*/) {}
+    // A job arrived and is ready to run
+    virtual void add(int job, int64_t remaining, int64_t now) = 0;
+    // A job left the CPU unfinished: its quantum expired or it was preempted
+    virtual void requeue(int job, int64_t remaining, bool /*expired*/, int64_t now) { add(job, remaining, now); }
+    virtual bool empty() const = 0;
+    virtual int next(int64_t now) = 0;
+    // Longest slice the job may run before it is requeued
+    virtual int64_t quantum(int /*job*/) const { return INT64_MAX; }
+    // Checked after arrivals: should the running job give up the CPU now?
+    virtual bool preempts(int /*running*/, int64_t /*remaining*/) const { return false; }
+};
+
+class FCFSPolicy : public SchedulingPolicy {
+    deque<int> ready;
+
+public:
+    string name() const override { return "FCFS"; }
+    void add(int job, int64_t, int64_t) override { ready.push_back(job); }
+    bool empty() const override { return ready.empty(); }
+    int next(int64_t) override {
+        int job = ready.front();
+        ready.pop_front();
+        return job;
+    }
+};
+
+// SJF picks the shortest burst and runs it to completion; SRTF also
+// preempts the running job when a shorter one arrives.
+class ShortestFirstPolicy : public SchedulingPolicy {
+    priority_queue<pair<int64_t, int>, vector<pair<int64_t, int>>, greater<pair<int64_t, int>>> ready;
+    bool preemptive;
+
+public:
+    ShortestFirstPolicy(bool preemptive) : preemptive(preemptive) {}
+    string name() const override { return preemptive ? "SRTF" : "SJF"; }
+    void add(int job, int64_t remaining, int64_t) override { ready.push({remaining, job}); }
+    bool empty() const override { return ready.empty(); }
+    int next(int64_t) override {
+        int job = ready.top().second;
+        ready.pop();
+        return job;
+    }
+    bool preempts(int, int64_t remaining) const override {
+        return preemptive && !ready.empty() && ready.top().first < remaining;
+    }
+};
+
+class RoundRobinPolicy : public SchedulingPolicy {
+    deque<int> ready;
+    int64_t slice;
+
+public:
+    RoundRobinPolicy(int64_t quantum) : slice(quantum) {
+        if (quantum <= 0) throw invalid_argument("Quantum must be positive.");
+    }
+    string name() const override { return "RR(q=" + to_string(slice) + ")"; }
+    void add(int job, int64_t, int64_t) override { ready.push_back(job); }
+    bool empty() const override { return ready.empty(); }
+    int next(int64_t) override {
+        int job = ready.front();
+        ready.pop_front();
+        return job;
+    }
+    int64_t quantum(int) const override { return slice; }
+};
+
+// Multi-level feedback queue: new jobs start at the top level, a job that
+// uses its whole quantum drops one level (quantum doubles per level), a
+// higher level preempts a lower one, and every boostPeriod all waiting jobs
+// return to the top so long jobs cannot starve.
+class MLFQPolicy : public SchedulingPolicy {
+    vector<deque<int>> levels;
+    vector<uint8_t> level;
+    int64_t baseQuantum, boostPeriod, lastBoost = 0;
+    size_t waiting = 0;
+
+public:
+    MLFQPolicy(int levelCount, int64_t baseQuantum, int64_t boostPeriod)
+        : levels(max(levelCount, 0)), baseQuantum(baseQuantum), boostPeriod(boostPeriod) {
+        if (levelCount <= 0 || levelCount > 32 || baseQuantum <= 0 || boostPeriod <= 0) {
+            throw invalid_argument("Invalid MLFQ configuration.");
+        }
+    }
+    string name() const override { return "MLFQ(" + to_string(levels.size()) + ")"; }
+    void reset(size_t jobCount) override {
+        level.assign(jobCount, 0);
+        for (auto& q : levels) q.clear();
+        waiting = 0;
+        lastBoost = 0;
+    }
+    void add(int job, int64_t, int64_t) override {
+        level[job] = 0;
+        levels[0].push_back(job);
+        waiting++;
+    }
+    void requeue(int job, int64_t, bool expired, int64_t) override {
+        if (expired && level[job] + 1 < int(levels.size())) level[job]++;
+        levels[level[job]].push_back(job);
+        waiting++;
+    }
+    bool empty() const override { return waiting == 0; }
+    int next(int64_t now) override {
+        if (now - lastBoost >= boostPeriod) {
+            for (size_t l = 1; l < levels.size(); l++) {
+                for (int job : levels[l]) level[job] = 0;
+                levels[0].insert(levels[0].end(), levels[l].begin(), levels[l].end());
+                levels[l].clear();
+            }
+            lastBoost = now;
+        }
+        for (auto& q : levels) {
+            if (!q.empty()) {
+                int job = q.front();
+                q.pop_front();
+                waiting--;
+                return job;
+            }
+        }
+        throw underflow_error("MLFQ is empty! Nothing to schedule.");
+    }
+    int64_t quantum(int job) const override { return baseQuantum << level[job]; }
+    bool preempts(int running, int64_t) const override {
+        for (int l = 0; l < level[running]; l++)
+            if (!levels[l].empty()) return true;
+        return false;
+    }
+};
+
+// Mean and tail of a latency distribution
+struct LatencySummary {
+    double mean = 0;
+    int64_t p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+
+    // Reorders `values` in place (successive nth_element passes)
+    static LatencySummary of(vector<int64_t>& values) {
+        LatencySummary s;
+        if (values.empty()) return s;
+        long double total = 0;
+        for (int64_t v : values) total += v;
+        s.mean = double(total / values.size());
+        auto lo = values.begin();
+        auto pick = [&](double q) {
+            auto it = values.begin() + size_t(q * (values.size() - 1));
+            nth_element(lo, it, values.end());
+            lo = it;
+            return *it;
+        };
+        s.p50 = pick(0.5);
+        s.p90 = pick(0.9);
+        s.p99 = pick(0.99);
+        s.p999 = pick(0.999);
+        s.max = *max_element(lo, values.end());
+        return s;
+    }
+};
+
+struct SimulationResult {
+    vector<int64_t> completionTime;  // per job
+    int64_t makespan = 0;
+    int64_t busyTime = 0;
+    size_t dispatches = 0;
+    size_t preemptions = 0;
+};
+
+// Single-CPU discrete-event simulator. The virtual clock jumps from event to
+// event through a binary-heap event queue: arrivals are fed lazily from the
+// arrival-sorted trace, and each dispatch schedules one slice-end event.
+// Preemption invalidates the pending slice end via a token instead of
+// searching the heap.
+class EventSimulator {
+    enum EventKind { Arrival = 0, SliceEnd = 1 };  // arrivals first on ties
+
+    struct Event {
+        int64_t time;
+        EventKind kind;
+        int job;
+        uint32_t token;
+    };
+
+    struct Later {
+        bool operator()(const Event& a, const Event& b) const {
+            return a.time != b.time ? a.time > b.time : a.kind > b.kind;
+        }
+    };
+
+public:
+    static SimulationResult run(const vector<TraceJob>& trace, SchedulingPolicy& policy) {
+        if (trace.size() > size_t(INT32_MAX)) throw length_error("Trace too large.");
+        for (size_t i = 1; i < trace.size(); i++) {
+            if (trace[i].arrivalTime < trace[i - 1].arrivalTime) {
+                throw invalid_argument("Trace must be sorted by arrival time.");
+            }
+        }
+        int n = int(trace.size());
+        SimulationResult result;
+        result.completionTime.assign(n, 0);
+        vector<int64_t> remaining(n);
+        policy.reset(n);
+
+        priority_queue<Event, vector<Event>, Later> events;
+        int nextArrival = 0;
+        if (n) events.push({trace[0].arrivalTime, Arrival, 0, 0});
+        int running = -1;
+        int64_t sliceStart = 0;
+        uint32_t token = 0;
+
+        while (!events.empty()) {
+            int64_t now = events.top().time;
+            // Apply every event at this instant before making a decision
+            while (!events.empty() && events.top().time == now) {
+                Event e = events.top();
+                events.pop();
+                if (e.kind == Arrival) {
+                    if (trace[e.job].burstTime <= 0) throw invalid_argument("Burst time must be positive.");
+                    remaining[e.job] = trace[e.job].burstTime;
+                    policy.add(e.job, remaining[e.job], now);
+                    if (++nextArrival < n) events.push({trace[nextArrival].arrivalTime, Arrival, nextArrival, 0});
+                } else if (e.token == token && running >= 0) {
+                    remaining[running] -= now - sliceStart;
+                    result.busyTime += now - sliceStart;
+                    if (remaining[running] == 0) result.completionTime[running] = now;
+                    else policy.requeue(running, remaining[running], true, now);
+                    running = -1;
+                }
+            }
+
+            if (running >= 0) {
+                int64_t left = remaining[running] - (now - sliceStart);
+                if (policy.preempts(running, left)) {
+                    result.busyTime += now - sliceStart;
+                    remaining[running] = left;
+                    policy.requeue(running, left, false, now);
+                    running = -1;
+                    token++;  // the pending slice end is now stale
+                    result.preemptions++;
+                }
+            }
+
+            if (running < 0 && !policy.empty()) {
+                running = policy.next(now);
+                sliceStart = now;
+                int64_t slice = min(remaining[running], policy.quantum(running));
+                events.push({now + slice, SliceEnd, running, ++token});
+                result.dispatches++;
+            }
+            result.makespan = now;
+        }
+        return result;
+    }
+};
+
+// Synthetic trace: Poisson arrivals at the given CPU load, bimodal bursts
+// (90% short interactive jobs, 10% long batch jobs)
+vector<TraceJob> makeTrace(size_t count, double load, uint64_t seed) {
+    mt19937_64 rng(seed);
+    exponential_distribution<double> shortBurst(1.0 / 5), longBurst(1.0 / 50);
+    uniform_real_distribution<double> coin(0, 1);
+    double meanBurst = 0.9 * 6 + 0.1 * 51;
+    exponential_distribution<double> gap(load / meanBurst);
+    vector<TraceJob> trace(count);
+    double clock = 0;
+    for (auto& job : trace) {
+        clock += gap(rng);
+        job.arrivalTime = int64_t(clock);
+        job.burstTime = 1 + int32_t(coin(rng) < 0.9 ? shortBurst(rng) : longBurst(rng));
+    }
+    return trace;
+}
+
+// Text trace: one "arrivalTime burstTime" pair per line, sorted by arrival
+vector<TraceJob> loadTrace(const string& path) {
+    ifstream in(path);
+    if (!in) throw runtime_error("Cannot open trace file: " + path);
+    vector<TraceJob> trace;
+    int64_t arrival;
+    int32_t burst;
+    while (in >> arrival >> burst) trace.push_back({arrival, burst});
+    return trace;
+}
+
+vector<unique_ptr<SchedulingPolicy>> standardPolicies() {
+    vector<unique_ptr<SchedulingPolicy>> policies;
+    policies.push_back(make_unique<FCFSPolicy>());
+    policies.push_back(make_unique<ShortestFirstPolicy>(false));
+    policies.push_back(make_unique<ShortestFirstPolicy>(true));
+    policies.push_back(make_unique<RoundRobinPolicy>(4));
+    policies.push_back(make_unique<MLFQPolicy>(3, 4, 1000));
+    return policies;
+}
+
+// Replays a trace under every policy and reports latency percentiles
+void comparePolicies(const vector<TraceJob>& trace) {
+    cout << "\nReplaying " << trace.size() << " processes per policy (times in ms):\n";
+    cout << left << setw(10) << "Policy" << right << setw(9) << "sim (s)" << setw(11) << "wait avg"
+         << setw(8) << "p50" << setw(8) << "p99" << setw(9) << "p99.9" << setw(11) << "turn avg"
+         << setw(8) << "p50" << setw(8) << "p99" << setw(9) << "p99.9" << "\n";
+    vector<int64_t> waits(trace.size()), turnarounds(trace.size());
+    for (auto& policy : standardPolicies()) {
+        auto t0 = chrono::steady_clock::now();
+        SimulationResult r = EventSimulator::run(trace, *policy);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        for (size_t i = 0; i < trace.size(); i++) {
+            turnarounds[i] = r.completionTime[i] - trace[i].arrivalTime;
+            waits[i] = turnarounds[i] - trace[i].burstTime;
+        }
+        LatencySummary w = LatencySummary::of(waits), t = LatencySummary::of(turnarounds);
+        cout << left << setw(10) << policy->name() << right << fixed << setprecision(2) << setw(9) << secs
+             << setprecision(1) << setw(11) << w.mean << setw(8) << w.p50 << setw(8) << w.p99 << setw(9) << w.p999
+             << setw(11) << t.mean << setw(8) << t.p50 << setw(8) << t.p99 << setw(9) << t.p999 << "\n";
+        cout.unsetf(ios::floatfield);
+    }
+}
+
 // CPU Scheduler class to simulate process execution
 class CPUScheduler {
 private:
@@ -140,6 +486,27 @@ public:
         displayMetrics();
     }
 
+    // Simulate the queued processes (all arriving at 0) under any policy
+    // without consuming the queue
+    void simulate(SchedulingPolicy& policy) const {
+        vector<Process> processes = processQueue.snapshot();
+        vector<TraceJob> trace;
+        for (const auto& p : processes) trace.push_back({0, p.burstTime});
+        SimulationResult r = EventSimulator::run(trace, policy);
+        double waiting = 0, turnaround = 0;
+        cout << policy.name() << ":";
+        for (size_t i = 0; i < processes.size(); i++) {
+            cout << " P" << processes[i].processId << "@" << r.completionTime[i];
+            turnaround += r.completionTime[i];
+            waiting += r.completionTime[i] - processes[i].burstTime;
+        }
+        if (!processes.empty()) {
+            cout << " | Avg Waiting: " << waiting / processes.size()
+                 << "ms | Avg Turnaround: " << turnaround / processes.size() << "ms";
+        }
+        cout << "\n";
+    }
+
     // Display average waiting and turnaround times
     void displayMetrics() const {
         if (processCount == 0) {
@@ -160,7 +527,7 @@ public:
 };
 
 // Main function to demonstrate the queue and CPU scheduling
-int main() {
+int main(int argc, char** argv) {
     try {
         CPUScheduler scheduler;
 
@@ -175,9 +542,22 @@ int main() {
         cout << "\nQueue before execution:\n";
         scheduler.displayQueue();
 
+        // Compare scheduling policies on the same queue
+        cout << "\nCompletion times under each policy:\n";
+        for (auto& policy : standardPolicies()) {
+            scheduler.simulate(*policy);
+        }
+
         // Execute the processes
         scheduler.executeProcesses();
 
+        // Usage: 02-Queue_CPU_Scheduling [--benchmark [processes] | --trace file]
+        if (argc > 2 && string(argv[1]) == "--trace") {
+            comparePolicies(loadTrace(argv[2]));
+        } else if (argc > 1 && string(argv[1]) == "--benchmark") {
+            comparePolicies(makeTrace(argc > 2 ? stoul(argv[2]) : 10000000, 0.9, 18));
+        }
+
     } catch (const exception& e) {
         cerr << "Error: " << e.what() << endl;
         return 1;
@@ -1,12 +1,16 @@
 #include <iostream>
-#include <queue>
+#include <sstream>
+#include <string>
 #include <vector>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <memory>
 #include <chrono>
+#include <cstdint>
+#include <functional>
 #include <stdexcept>
 #include <algorithm>
-#include <condition_variable>
 
 using namespace std;
 
@@ -19,129 +23,265 @@ struct Process {
     int turnaroundTime;  // Time from arrival to completion
     int completionTime;  // Time when process finishes
 
-    Process(int id, int bt, int at) 
-        : processId(id), burstTime(bt), arrivalTime(at), waitingTime(0), 
+    Process(int id, int bt, int at)
+        : processId(id), burstTime(bt), arrivalTime(at), waitingTime(0),
           turnaroundTime(0), completionTime(0) {}
 };
 
-// Class to manage the multi-core CPU scheduler with a priority queue
+// Chase-Lev work-stealing deque (Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models", PPoPP 2013).
+// The owning core pushes and pops at the bottom; other cores steal from the top.
+template <typename T>
+class WorkStealingDeque {
+    struct Buffer {
+        int64_t capacity;
+        unique_ptr<atomic<T>[]> slots;
+
+        explicit Buffer(int64_t cap) : capacity(cap), slots(new atomic<T>[cap]) {}
+        T get(int64_t i) const { return slots[i & (capacity - 1)].load(memory_order_relaxed); }
+        void put(int64_t i, T x) { slots[i & (capacity - 1)].store(x, memory_order_relaxed); }
+    };
+
+    alignas(64) atomic<int64_t> top{0};
+    alignas(64) atomic<int64_t> bottom{0};
+    atomic<Buffer*> buffer;
+    vector<unique_ptr<Buffer>> buffers;  // old buffers stay alive for in-flight thieves
+
+    Buffer* grow(Buffer* old, int64_t b, int64_t t) {
+        buffers.push_back(make_unique<Buffer>(old->capacity * 2));
+        Buffer* a = buffers.back().get();
+        for (int64_t i = t; i < b; i++) a->put(i, old->get(i));
+        buffer.store(a, memory_order_release);
+        return a;
+    }
+
+public:
+    enum StealResult { Empty, Abort, Success };
+
+    explicit WorkStealingDeque(int64_t capacity = 64) {
+        int64_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        buffers.push_back(make_unique<Buffer>(cap));
+        buffer.store(buffers.back().get(), memory_order_relaxed);
+    }
+
+    // Owner only.
+    void push(T x) {
+        int64_t b = bottom.load(memory_order_relaxed);
+        int64_t t = top.load(memory_order_acquire);
+        Buffer* a = buffer.load(memory_order_relaxed);
+        if (b - t > a->capacity - 1) a = grow(a, b, t);
+        a->put(b, x);
+        atomic_thread_fence(memory_order_release);
+        bottom.store(b + 1, memory_order_relaxed);
+    }
+
+    // Owner only.
+    bool pop(T& out) {
+        int64_t b = bottom.load(memory_order_relaxed) - 1;
+        Buffer* a = buffer.load(memory_order_relaxed);
+        bottom.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t t = top.load(memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, memory_order_relaxed);
+            return false;
+        }
+        out = a->get(b);
+        if (t < b) return true;
+        // Last element: race the thieves for it.
+        bool won = top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+        bottom.store(b + 1, memory_order_relaxed);
+        return won;
+    }
+
+    // Any thread.
+    StealResult steal(T& out) {
+        int64_t t = top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t b = bottom.load(memory_order_acquire);
+        if (t >= b) return Empty;
+        T x = buffer.load(memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed)) return Abort;
+        out = x;
+        return Success;
+    }
+};
+
+// Class to manage the multi-core CPU scheduler with per-core work-stealing run queues
 class MultiCoreScheduler {
 private:
-    // Custom comparator for priority queue (earliest arrival first)
-    struct CompareArrival {
-        bool operator()(const Process& a, const Process& b) {
-            return a.arrivalTime > b.arrivalTime;
+    // Everything a core touches while running, kept on its own cache lines
+    struct alignas(64) CoreState {
+        WorkStealingDeque<uint32_t> runQueue;
+        vector<Process> completed;
+        vector<Process> logBatch;
+        long long waitingTime = 0;
+        long long turnaroundTime = 0;
+        atomic<int> clock{0};  // virtual time at which the next process dealt here can start
+
+        explicit CoreState(size_t capacity) : runQueue(int64_t(capacity)) {}
+
+        // Books [start, start + burst) on this core's virtual timeline
+        int reserve(int arrivalTime, int burstTime) {
+            int now = clock.load(memory_order_relaxed);
+            int start;
+            do {
+                start = max(now, arrivalTime);
+            } while (!clock.compare_exchange_weak(now, start + burstTime, memory_order_relaxed));
+            return start;
         }
     };
-    
-    priority_queue<Process, vector<Process>, CompareArrival> processQueue;
+
+    static constexpr size_t LOG_BATCH = 256;
+
+    vector<Process> processes;  // submitted processes, sorted by arrival at execution
     vector<Process> completedProcesses;
+    vector<unique_ptr<CoreState>> cores;
     int numCores;
+    bool verbose;
     mutex queueMtx;
     mutable mutex outputMtx;
-    mutex metricsMtx;
-    condition_variable cv;
     bool done = false;
-    int totalWaitingTime;
-    int totalTurnaroundTime;
-    int totalBurstTime;
+    function<void(const Process&)> execute;
+    long long totalWaitingTime;
+    long long totalTurnaroundTime;
+    long long totalBurstTime;
     int simulationTime;
 
+    // Formats the batch outside the lock, then writes it with one locked call
+    void flushLog(int coreId, CoreState& core) {
+        if (core.logBatch.empty()) return;
+        ostringstream out;
+        for (const auto& process : core.logBatch) {
+            out << "Core " << coreId << " executed Process " << process.processId
+                << " | Burst: " << process.burstTime << "ms | Waiting: "
+                << process.waitingTime << "ms | Turnaround: " << process.turnaroundTime
+                << "ms | Completed: " << process.completionTime << "ms\n";
+        }
+        core.logBatch.clear();
+        lock_guard<mutex> outputLock(outputMtx);
+        cout << out.str();
+    }
+
+    // Sweeps the other cores starting at a random victim. Gives up only when
+    // every deque reported Empty; a lost race (Abort) means work may remain.
+    bool steal(int coreId, uint64_t& rng, uint32_t& task) {
+        while (true) {
+            bool contended = false;
+            rng ^= rng << 13, rng ^= rng >> 7, rng ^= rng << 17;
+            int start = int(rng % uint64_t(numCores));
+            for (int k = 0; k < numCores; k++) {
+                int victim = (start + k) % numCores;
+                if (victim == coreId) continue;
+                auto result = cores[victim]->runQueue.steal(task);
+                if (result == WorkStealingDeque<uint32_t>::Success) return true;
+                if (result == WorkStealingDeque<uint32_t>::Abort) contended = true;
+            }
+            if (!contended) return false;
+            this_thread::yield();
+        }
+    }
+
 public:
-    MultiCoreScheduler(int cores) 
-        : numCores(cores), totalWaitingTime(0), totalTurnaroundTime(0), 
+    MultiCoreScheduler(int cores, bool verbose = true)
+        : numCores(cores), verbose(verbose), totalWaitingTime(0), totalTurnaroundTime(0),
           totalBurstTime(0), simulationTime(0) {
         if (numCores <= 0) {
             throw invalid_argument("Number of cores must be positive.");
         }
+        // Simulate execution time (scaled down for demo)
+        execute = [](const Process&) { this_thread::sleep_for(chrono::milliseconds(10)); };
     }
 
-    // Add a process to the priority queue
+    // Replaces the per-process work (the default sleeps 10ms)
+    void setExecutor(function<void(const Process&)> fn) { execute = move(fn); }
+
+    // Add a process to the pending list
     void addProcess(int processId, int burstTime, int arrivalTime) {
         lock_guard<mutex> lock(queueMtx);
-        processQueue.push(Process(processId, burstTime, arrivalTime));
+        if (done) {
+            throw logic_error("Cannot add processes after signalDone().");
+        }
+        processes.push_back(Process(processId, burstTime, arrivalTime));
         totalBurstTime += burstTime;
-        lock_guard<mutex> outputLock(outputMtx);
-        cout << "Added Process " << processId << " (Burst: " << burstTime 
-             << "ms, Arrival: " << arrivalTime << "ms)\n";
-        cv.notify_one();
+        if (verbose) {
+            lock_guard<mutex> outputLock(outputMtx);
+            cout << "Added Process " << processId << " (Burst: " << burstTime
+                 << "ms, Arrival: " << arrivalTime << "ms)\n";
+        }
     }
 
-    // Simulate a single core's execution
-    void coreWorker(int coreId, vector<Process>& localCompleted, int& coreEndTime) {
-        int currentTime = 0;
-        unique_lock<mutex> lock(queueMtx);
-        while (!done || !processQueue.empty()) {
-            cv.wait(lock, [this] { return done || !processQueue.empty(); });
+    // Simulate a single core's execution: drain the own deque, then steal
+    void coreWorker(int coreId) {
+        CoreState& core = *cores[coreId];
+        uint64_t rng = 0x9E3779B97F4A7C15ULL * (coreId + 1);
+        uint32_t task;
+        while (core.runQueue.pop(task) || steal(coreId, rng, task)) {
+            Process process = processes[task];
+            execute(process);
 
-            if (processQueue.empty()) {
-                break;
-            }
-
-            Process process = processQueue.top();
-            processQueue.pop();
-            lock.unlock();
-
-            // Simulate execution time (scaled down for demo)
-            this_thread::sleep_for(chrono::milliseconds(10));
-
-            // Calculate metrics
-            int startTime = max(currentTime, process.arrivalTime);
+            // Calculate metrics. A stolen process starts when the victim's work
+            // became available, unless the thief's own timeline frees up earlier.
+            CoreState& home = *cores[task % numCores];
+            bool homeFirst = home.clock.load(memory_order_relaxed) <= core.clock.load(memory_order_relaxed);
+            int startTime = (homeFirst ? home : core).reserve(process.arrivalTime, process.burstTime);
             process.waitingTime = startTime - process.arrivalTime;
             process.turnaroundTime = process.waitingTime + process.burstTime;
             process.completionTime = startTime + process.burstTime;
-            currentTime = process.completionTime;
 
-            // Update global metrics
-            {
-                lock_guard<mutex> metricsLock(metricsMtx);
-                totalWaitingTime += process.waitingTime;
-                totalTurnaroundTime += process.turnaroundTime;
+            core.waitingTime += process.waitingTime;
+            core.turnaroundTime += process.turnaroundTime;
+            core.completed.push_back(process);
+            if (verbose) {
+                core.logBatch.push_back(process);
+                if (core.logBatch.size() >= LOG_BATCH) flushLog(coreId, core);
             }
-
-            // Thread-safe output
-            {
-                lock_guard<mutex> outputLock(outputMtx);
-                cout << "Core " << coreId << " executed Process " << process.processId 
-                     << " | Burst: " << process.burstTime << "ms | Waiting: " 
-                     << process.waitingTime << "ms | Turnaround: " << process.turnaroundTime 
-                     << "ms | Completed: " << process.completionTime << "ms\n";
-            }
-
-            localCompleted.push_back(process);
-            lock.lock();
         }
-        coreEndTime = currentTime;
+        if (verbose) flushLog(coreId, core);
     }
 
     // Execute processes across all cores
     void executeProcesses() {
-        {
+        if (verbose) {
             lock_guard<mutex> lock(outputMtx);
             cout << "\nStarting Multi-Core Execution (FCFS Scheduling):\n";
         }
 
-        vector<thread> threads;
-        vector<vector<Process>> threadResults(numCores);
-        vector<int> coreEndTimes(numCores, 0);
+        // Seed: deal the arrival-ordered processes round-robin (process k to
+        // core k % numCores), pushed latest-first, so every owner pops the
+        // globally earliest work it holds and thieves take the latest.
+        stable_sort(processes.begin(), processes.end(),
+                    [](const Process& a, const Process& b) { return a.arrivalTime < b.arrivalTime; });
+        cores.clear();
+        size_t n = processes.size();
+        for (int i = 0; i < numCores; i++) {
+            cores.push_back(make_unique<CoreState>(n / numCores + 1));
+        }
+        for (size_t k = n; k-- > 0;) cores[k % numCores]->runQueue.push(uint32_t(k));
 
+        vector<thread> threads;
         for (int i = 0; i < numCores; i++) {
-            threads.emplace_back(&MultiCoreScheduler::coreWorker, this, i, 
-                                 ref(threadResults[i]), ref(coreEndTimes[i]));
+            threads.emplace_back(&MultiCoreScheduler::coreWorker, this, i);
         }
 
         for (auto& t : threads) {
             t.join();
         }
 
-        for (const auto& result : threadResults) {
-            completedProcesses.insert(completedProcesses.end(), result.begin(), result.end());
+        simulationTime = 0;
+        for (const auto& core : cores) {
+            completedProcesses.insert(completedProcesses.end(), core->completed.begin(), core->completed.end());
+            totalWaitingTime += core->waitingTime;
+            totalTurnaroundTime += core->turnaroundTime;
+            simulationTime = max(simulationTime, core->clock.load());
         }
-
-        simulationTime = *max_element(coreEndTimes.begin(), coreEndTimes.end());
-        displayMetrics();
+        processes.clear();
+        if (verbose) displayMetrics();
     }
 
+    size_t completedCount() const { return completedProcesses.size(); }
+
     void displayMetrics() const {
         lock_guard<mutex> lock(outputMtx);
         if (completedProcesses.empty()) {
@@ -162,8 +302,8 @@ public:
 
         cout << "\nCompleted Processes:\n";
         for (const auto& p : completedProcesses) {
-            cout << "Process " << p.processId << " | Waiting: " << p.waitingTime 
-                 << "ms | Turnaround: " << p.turnaroundTime << "ms | Completed: " 
+            cout << "Process " << p.processId << " | Waiting: " << p.waitingTime
+                 << "ms | Turnaround: " << p.turnaroundTime << "ms | Completed: "
                  << p.completionTime << "ms\n";
         }
     }
@@ -171,11 +311,39 @@ public:
     void signalDone() {
         lock_guard<mutex> lock(queueMtx);
         done = true;
-        cv.notify_all();
     }
 };
 
-int main() {
+// Scaling benchmark: 10^6 tiny tasks on 1..64 cores, logging off
+void benchmark(int tasks) {
+    cout << "Work-stealing scaling, " << tasks << " tasks (" << thread::hardware_concurrency()
+         << " hardware threads available)\n";
+    double base = 0;
+    for (int numCores = 1; numCores <= 64; numCores *= 2) {
+        MultiCoreScheduler scheduler(numCores, false);
+        scheduler.setExecutor([](const Process& p) {
+            volatile int sink = 0;
+            for (int i = 0; i < p.burstTime * 16; i++) sink = sink + i;
+        });
+        for (int i = 0; i < tasks; i++) scheduler.addProcess(i, 1 + i % 8, i / 4);
+        scheduler.signalDone();
+
+        auto t0 = chrono::steady_clock::now();
+        scheduler.executeProcesses();
+        double s = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        if (numCores == 1) base = s;
+        cout << "  " << numCores << " cores: " << s * 1e3 << " ms, " << tasks / s / 1e6 << " M tasks/s, speedup "
+             << base / s << "x" << (scheduler.completedCount() == size_t(tasks) ? "" : "  LOST TASKS") << "\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    // Usage: 03-Queue_CPU_Multi_Core_FCFS --benchmark [tasks]
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        benchmark(argc > 2 ? stoi(argv[2]) : 1000000);
+        return 0;
+    }
+
     try {
         int numCores;
         cout << "Enter the number of CPU cores: ";
@@ -199,4 +367,4 @@ int main() {
     }
 
     return 0;
-}
\ No newline at end of file
+}
@@ -3,6 +3,12 @@
 #include <vector>
 #include <cstdlib>
 #include <ctime>
+#include <cstdint>
+#include <random>
+#include <chrono>
+#include <utility>
+#include <functional>
+#include <string>
 
 using namespace std;
 
@@ -22,7 +28,256 @@ struct ComparePriority {
     }
 };
 
-int main() {
+// Handle returned by TimingWheel::schedule; stale once the timer fires or is cancelled
+struct TimerHandle {
+    uint32_t index;
+    uint32_t generation;
+};
+
+// Hierarchical timing wheel: 4 levels of 256 slots cover 2^32 ticks.
+// A timer goes into the lowest level whose span covers its delay, so
+// schedule and cancel are O(1). Each time a level wraps, the next level's
+// current slot is cascaded down into finer slots. Timers live in a pooled
+// array of intrusive doubly-linked nodes addressed by index; each slot's
+// list head is a sentinel node in that same array.
+class TimingWheel {
+private:
+    static const int LEVEL_BITS = 8;
+    static const uint32_t SLOTS = 1u << LEVEL_BITS;
+    static const int LEVELS = 4;
+    static const uint32_t FIRING = LEVELS * SLOTS;  // sentinel for timers being fired
+    static const uint32_t NONE = UINT32_MAX;
+    static constexpr uint64_t MAX_DELTA = (1ull << (LEVEL_BITS * LEVELS)) - 1;
+
+    struct TimerNode {
+        uint32_t prev, next;
+        uint32_t generation;
+        bool active;
+        uint64_t expiry;
+        Job job;
+    };
+
+    vector<TimerNode> nodes;
+    uint32_t freeList = NONE;
+    uint64_t current = 0;  // next tick to process
+    size_t live = 0;
+
+    void linkTail(uint32_t head, uint32_t n) {
+        uint32_t last = nodes[head].prev;
+        nodes[n].prev = last;
+        nodes[n].next = head;
+        nodes[last].next = n;
+        nodes[head].prev = n;
+    }
+
+    void unlink(uint32_t n) {
+        nodes[nodes[n].prev].next = nodes[n].next;
+        nodes[nodes[n].next].prev = nodes[n].prev;
+    }
+
+    // Moves every timer in list `from` to the empty list `to`
+    void splice(uint32_t from, uint32_t to) {
+        if (nodes[from].next == from) return;
+        nodes[to].next = nodes[from].next;
+        nodes[to].prev = nodes[from].prev;
+        nodes[nodes[to].next].prev = to;
+        nodes[nodes[to].prev].next = to;
+        nodes[from].next = nodes[from].prev = from;
+    }
+
+    void place(uint32_t n) {
+        uint64_t expiry = nodes[n].expiry;
+        uint64_t delta = expiry > current ? expiry - current : 0;
+        if (delta > MAX_DELTA) {  // beyond the wheel: park in the farthest slot, re-placed on cascade
+            delta = MAX_DELTA;
+            expiry = current + MAX_DELTA;
+        }
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (1ull << (LEVEL_BITS * (level + 1)))) level++;
+        if (level == 0 && expiry < current) expiry = current;
+        uint32_t slot = uint32_t(expiry >> (LEVEL_BITS * level)) & (SLOTS - 1);
+        linkTail(level * SLOTS + slot, n);
+    }
+
+    // Re-places the current slot of `level`; returns that slot index
+    uint32_t cascade(int level) {
+        uint32_t slot = uint32_t(current >> (LEVEL_BITS * level)) & (SLOTS - 1);
+        splice(level * SLOTS + slot, FIRING);
+        while (nodes[FIRING].next != FIRING) {
+            uint32_t n = nodes[FIRING].next;
+            unlink(n);
+            place(n);
+        }
+        return slot;
+    }
+
+    void release(uint32_t n) {
+        nodes[n].active = false;
+        nodes[n].generation++;
+        nodes[n].next = freeList;
+        freeList = n;
+        live--;
+    }
+
+public:
+    TimingWheel() {
+        nodes.reserve(FIRING + 1 + 1024);
+        for (uint32_t i = 0; i <= FIRING; i++) nodes.push_back({i, i, 0, false, 0, Job(0, 0)});
+    }
+
+    // Fires on the tick() that processes tick now() + delay
+    TimerHandle schedule(uint64_t delay, const Job& job) {
+        uint32_t n;
+        if (freeList != NONE) {
+            n = freeList;
+            freeList = nodes[n].next;
+        } else {
+            n = uint32_t(nodes.size());
+            nodes.push_back({0, 0, 0, false, 0, job});
+        }
+        nodes[n].active = true;
+        nodes[n].expiry = current + min(delay, UINT64_MAX - current);
+        nodes[n].job = job;
+        place(n);
+        live++;
+        return {n, nodes[n].generation};
+    }
+
+    // Returns false if the timer already fired or was cancelled
+    bool cancel(TimerHandle h) {
+        if (h.index <= FIRING || h.index >= nodes.size()) return false;
+        TimerNode& node = nodes[h.index];
+        if (!node.active || node.generation != h.generation) return false;
+        unlink(h.index);
+        release(h.index);
+        return true;
+    }
+
+    // Processes one tick, calling fire(job) for each expired timer. The
+    // callback may schedule and cancel; delay 0 then means the next tick.
+    template <typename F>
+    void tick(F&& fire) {
+        uint32_t slot = uint32_t(current) & (SLOTS - 1);
+        if (slot == 0) {
+            for (int level = 1; level < LEVELS && cascade(level) == 0; level++) {
+            }
+        }
+        splice(slot, FIRING);
+        current++;
+        while (nodes[FIRING].next != FIRING) {
+            uint32_t n = nodes[FIRING].next;
+            unlink(n);
+            Job job = nodes[n].job;
+            release(n);
+            fire(job);
+        }
+    }
+
+    uint64_t now() const { return current; }
+    size_t size() const { return live; }
+    size_t poolSize() const { return nodes.size() - FIRING - 1; }
+};
+
+// Baseline: the priority_queue approach with lazy cancellation
+class HeapTimers {
+private:
+    priority_queue<pair<uint64_t, uint32_t>, vector<pair<uint64_t, uint32_t>>,
+                   greater<pair<uint64_t, uint32_t>>> heap;
+    vector<bool> cancelled;
+    vector<int> priorities;
+    uint64_t current = 0;
+
+public:
+    using Handle = uint32_t;
+
+    Handle schedule(uint64_t delay, const Job& job) {
+        if (cancelled.size() <= size_t(job.jobId)) {
+            cancelled.resize(job.jobId + 1);
+            priorities.resize(job.jobId + 1);
+        }
+        priorities[job.jobId] = job.priority;
+        heap.push({current + delay, uint32_t(job.jobId)});
+        return uint32_t(job.jobId);
+    }
+
+    // Cancelled entries stay in the heap until they reach the top
+    bool cancel(Handle id) {
+        if (cancelled[id]) return false;
+        cancelled[id] = true;
+        return true;
+    }
+
+    template <typename F>
+    void tick(F&& fire) {
+        while (!heap.empty() && heap.top().first <= current) {
+            uint32_t id = heap.top().second;
+            heap.pop();
+            if (!cancelled[id]) {
+                cancelled[id] = true;
+                fire(Job(int(id), priorities[id]));
+            }
+        }
+        current++;
+    }
+
+    size_t entries() const { return heap.size(); }
+};
+
+struct WheelTimers {
+    using Handle = TimerHandle;
+    TimingWheel wheel;
+    Handle schedule(uint64_t delay, const Job& job) { return wheel.schedule(delay, job); }
+    bool cancel(Handle h) { return wheel.cancel(h); }
+    template <typename F>
+    void tick(F&& fire) { wheel.tick(fire); }
+    size_t entries() const { return wheel.poolSize(); }
+};
+
+// Timeout-heavy workload: every tick arms `perTick` timeouts of up to
+// `maxDelay` ticks, and 90% of them are cancelled before they expire (the
+// request finished in time). Returns a checksum of (job, tick) firings.
+template <typename Timers>
+uint64_t runTimeouts(Timers& timers, int ticks, int perTick, int maxDelay, double& seconds, size_t& peakEntries) {
+    mt19937_64 rng(20);
+    vector<vector<typename Timers::Handle>> cancelAt(maxDelay + 1);
+    uint64_t checksum = 0;
+    int nextId = 0;
+    peakEntries = 0;
+    auto t0 = chrono::steady_clock::now();
+    for (int t = 0; t < ticks; t++) {
+        auto& due = cancelAt[t % cancelAt.size()];
+        for (auto h : due) timers.cancel(h);
+        due.clear();
+        for (int k = 0; k < perTick; k++) {
+            uint64_t r = rng();
+            int delay = 1 + int(r % maxDelay);
+            auto h = timers.schedule(delay, Job(nextId++, int(r >> 60) & 3));
+            if ((r >> 32) % 10 != 0) cancelAt[(t + 1 + (r >> 40) % delay) % cancelAt.size()].push_back(h);
+        }
+        timers.tick([&](const Job& job) { checksum += uint64_t(job.jobId) * (t + 1); });
+        peakEntries = max(peakEntries, timers.entries());
+    }
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    return checksum;
+}
+
+void benchmarkTimers(int ticks, int perTick, int maxDelay) {
+    cout << "\n--- Timeout benchmark: " << ticks << " ticks x " << perTick << " timers, delay <= " << maxDelay
+         << ", 90% cancelled ---\n";
+    double heapSeconds, wheelSeconds;
+    size_t heapPeak, wheelPeak;
+    HeapTimers heap;
+    WheelTimers wheel;
+    uint64_t a = runTimeouts(heap, ticks, perTick, maxDelay, heapSeconds, heapPeak);
+    uint64_t b = runTimeouts(wheel, ticks, perTick, maxDelay, wheelSeconds, wheelPeak);
+    double timers = double(ticks) * perTick;
+    cout << "priority_queue: " << heapSeconds * 1e9 / timers << " ns per timer, peak " << heapPeak
+         << " heap entries\n";
+    cout << "timing wheel:   " << wheelSeconds * 1e9 / timers << " ns per timer, peak " << wheelPeak
+         << " pooled nodes" << (a == b ? "" : "  MISMATCH") << "\n";
+}
+
+int main(int argc, char** argv) {
     // Seed random number generator
     srand(time(0));
     
@@ -59,6 +314,27 @@ int main() {
         cout << currentJob.jobId << "\t" << currentJob.priority << "\n";
         jobQueue.pop();
     }
-    
+
+    // Same jobs as delayed timers: job i fires after 100 * (priority + 1) + i ticks
+    TimingWheel wheel;
+    vector<TimerHandle> handles;
+    for (const Job& job : jobList) {
+        handles.push_back(wheel.schedule(100 * (job.priority + 1) + job.jobId, job));
+    }
+    wheel.cancel(handles[0]);
+    cout << "\nTiming wheel (Job 1 cancelled):\n";
+    cout << "Tick\tJob ID\tPriority\n";
+    cout << "----------------\n";
+    while (wheel.size() > 0) {
+        uint64_t tick = wheel.now();
+        wheel.tick([&](const Job& job) {
+            cout << tick << "\t" << job.jobId << "\t" << job.priority << "\n";
+        });
+    }
+
+    // Usage: 04-Priority_Queue --benchmark
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        benchmarkTimers(200000, 50, 30000);
+    }
     return 0;
 }
\ No newline at end of file
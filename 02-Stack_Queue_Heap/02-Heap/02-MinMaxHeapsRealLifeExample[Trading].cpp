@@ -4,6 +4,20 @@
 #include <iomanip>
 #include <ctime>
 #include <unordered_map>
+#include <cstdint>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#ifdef __linux__
+#include <pthread.h>
+#endif
 
 using namespace std;
 
@@ -171,7 +185,665 @@ public:
     }
 };
 
-int main() {
+// ---------------- Price-ladder matching engine ----------------
+
+enum class Side : uint8_t { Bid, Ask };
+
+// POD order: integer price in ticks (e.g. cents), exchange-assigned dense id
+struct LimitOrder {
+    uint32_t id;
+    uint32_t price;
+    uint32_t quantity;
+    Side side;
+};
+
+struct Fill {
+    uint32_t bidId;
+    uint32_t askId;
+    uint32_t price;
+    uint32_t quantity;
+};
+
+// Set of prices as a hierarchy of 64-bit words: bit p of level 0 marks price
+// p, bit w of level 1 marks a non-empty level-0 word, and so on up to a
+// single word. next/prev find the nearest set price in O(levels).
+class PriceBitmap {
+private:
+    vector<vector<uint64_t>> levels;
+
+public:
+    PriceBitmap(size_t size) {
+        do {
+            size = (size + 63) / 64;
+            levels.emplace_back(size, 0);
+        } while (size > 1);
+    }
+
+    void set(uint64_t p) {
+        for (auto& level : levels) {
+            level[p >> 6] |= 1ull << (p & 63);
+            p >>= 6;
+        }
+    }
+
+    void clear(uint64_t p) {
+        for (auto& level : levels) {
+            level[p >> 6] &= ~(1ull << (p & 63));
+            if (level[p >> 6]) return;
+            p >>= 6;
+        }
+    }
+
+    // Smallest set price >= p, or -1
+    int64_t next(uint64_t p) const {
+        size_t l = 0;
+        while (true) {
+            uint64_t w = p >> 6;
+            if (w < levels[l].size()) {
+                uint64_t bits = levels[l][w] & (~0ull << (p & 63));
+                if (bits) {
+                    p = (w << 6) | __builtin_ctzll(bits);
+                    break;
+                }
+            }
+            p = w + 1;
+            if (++l == levels.size()) return -1;
+        }
+        while (l-- > 0) p = (p << 6) | __builtin_ctzll(levels[l][p]);
+        return int64_t(p);
+    }
+
+    // Largest set price <= p, or -1
+    int64_t prev(uint64_t p) const {
+        size_t l = 0;
+        p = min<uint64_t>(p, levels[0].size() * 64 - 1);
+        while (true) {
+            uint64_t w = p >> 6;
+            uint64_t bits = levels[l][w] & (~0ull >> (63 - (p & 63)));
+            if (bits) {
+                p = (w << 6) | (63 - __builtin_clzll(bits));
+                break;
+            }
+            if (w == 0 || ++l == levels.size()) return -1;
+            p = w - 1;
+        }
+        while (l-- > 0) p = (p << 6) | (63 - __builtin_clzll(levels[l][p]));
+        return int64_t(p);
+    }
+};
+
+// Order book as a ladder of per-price FIFO levels. Resting orders are
+// intrusive doubly-linked nodes from a pool (32-bit indices), found by id
+// through a flat index, so cancel is O(1). One bitmap per side tracks the
+// non-empty prices for best bid/ask. Fills go to a callback; nothing prints.
+class LadderOrderBook {
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct OrderNode {
+        uint32_t id;
+        uint32_t price;
+        uint32_t quantity;
+        uint32_t prev, next;
+        Side side;
+    };
+
+    struct PriceLevel {
+        uint32_t head = NONE, tail = NONE;
+        uint64_t quantity = 0;
+    };
+
+    uint32_t maxPrice;
+    vector<PriceLevel> bidLevels, askLevels;
+    PriceBitmap bidPrices, askPrices;
+    int64_t bestBid = -1, bestAsk = -1;
+    vector<OrderNode> nodes;
+    uint32_t freeList = NONE;
+    vector<uint32_t> nodeOf;  // order id -> node index
+    size_t restingCount = 0;
+
+    PriceLevel& levelOf(Side side, uint32_t price) {
+        return side == Side::Bid ? bidLevels[price] : askLevels[price];
+    }
+
+    uint32_t allocate() {
+        if (freeList != NONE) {
+            uint32_t n = freeList;
+            freeList = nodes[n].next;
+            return n;
+        }
+        nodes.push_back({});
+        return uint32_t(nodes.size() - 1);
+    }
+
+    void rest(const LimitOrder& order) {
+        if (order.id >= nodeOf.size()) nodeOf.resize(max<size_t>(order.id + 1, nodeOf.size() * 2), NONE);
+        uint32_t n = allocate();
+        PriceLevel& level = levelOf(order.side, order.price);
+        nodes[n] = {order.id, order.price, order.quantity, level.tail, NONE, order.side};
+        if (level.tail != NONE) nodes[level.tail].next = n;
+        else level.head = n;
+        level.tail = n;
+        level.quantity += order.quantity;
+        nodeOf[order.id] = n;
+        restingCount++;
+        if (order.side == Side::Bid) {
+            bidPrices.set(order.price);
+            bestBid = max<int64_t>(bestBid, order.price);
+        } else {
+            askPrices.set(order.price);
+            if (bestAsk < 0 || order.price < bestAsk) bestAsk = order.price;
+        }
+    }
+
+    // Unlinks and frees node n, fixing the level and the best price
+    void remove(uint32_t n) {
+        OrderNode& node = nodes[n];
+        PriceLevel& level = levelOf(node.side, node.price);
+        if (node.prev != NONE) nodes[node.prev].next = node.next;
+        else level.head = node.next;
+        if (node.next != NONE) nodes[node.next].prev = node.prev;
+        else level.tail = node.prev;
+        level.quantity -= node.quantity;
+        if (level.head == NONE) {
+            if (node.side == Side::Bid) {
+                bidPrices.clear(node.price);
+                if (bestBid == node.price) bestBid = node.price ? bidPrices.prev(node.price - 1) : -1;
+            } else {
+                askPrices.clear(node.price);
+                if (bestAsk == node.price) bestAsk = askPrices.next(node.price + 1);
+            }
+        }
+        nodeOf[node.id] = NONE;
+        node.next = freeList;
+        freeList = n;
+        restingCount--;
+    }
+
+public:
+    LadderOrderBook(uint32_t maxPriceTicks)
+        : maxPrice(maxPriceTicks), bidLevels(maxPriceTicks + 1), askLevels(maxPriceTicks + 1),
+          bidPrices(maxPriceTicks + 1), askPrices(maxPriceTicks + 1) {}
+
+    // Matches against the opposite side, then rests any remainder.
+    // Calls onFill(const Fill&) per execution, at the resting order's price.
+    // An id that is already resting is rejected before any matching.
+    template <typename OnFill>
+    void addOrder(LimitOrder order, OnFill&& onFill) {
+        if (order.price > maxPrice) throw out_of_range("Price outside the ladder.");
+        if (order.id < nodeOf.size() && nodeOf[order.id] != NONE) throw invalid_argument("Duplicate order id.");
+        if (order.quantity == 0) return;
+        if (order.side == Side::Bid) {
+            while (order.quantity && bestAsk >= 0 && bestAsk <= order.price) {
+                PriceLevel& level = askLevels[bestAsk];
+                OrderNode& resting = nodes[level.head];
+                uint32_t qty = min(order.quantity, resting.quantity);
+                onFill(Fill{order.id, resting.id, resting.price, qty});
+                order.quantity -= qty;
+                resting.quantity -= qty;
+                level.quantity -= qty;
+                if (!resting.quantity) remove(level.head);
+            }
+        } else {
+            while (order.quantity && bestBid >= 0 && bestBid >= order.price) {
+                PriceLevel& level = bidLevels[bestBid];
+                OrderNode& resting = nodes[level.head];
+                uint32_t qty = min(order.quantity, resting.quantity);
+                onFill(Fill{resting.id, order.id, resting.price, qty});
+                order.quantity -= qty;
+                resting.quantity -= qty;
+                level.quantity -= qty;
+                if (!resting.quantity) remove(level.head);
+            }
+        }
+        if (order.quantity) rest(order);
+    }
+
+    void addOrder(const LimitOrder& order) {
+        addOrder(order, [](const Fill&) {});
+    }
+
+    // Reducing quantity at the same price keeps time priority; any other
+    // change is a cancel plus re-add, which loses priority and may trade.
+    // Returns false if the order is not resting.
+    template <typename OnFill>
+    bool modifyOrder(uint32_t id, uint32_t price, uint32_t quantity, OnFill&& onFill) {
+        if (id >= nodeOf.size() || nodeOf[id] == NONE) return false;
+        if (price > maxPrice) throw out_of_range("Price outside the ladder.");
+        uint32_t n = nodeOf[id];
+        OrderNode& node = nodes[n];
+        if (price == node.price && quantity > 0 && quantity <= node.quantity) {
+            levelOf(node.side, price).quantity -= node.quantity - quantity;
+            node.quantity = quantity;
+            return true;
+        }
+        Side side = node.side;
+        remove(n);
+        addOrder(LimitOrder{id, price, quantity, side}, onFill);
+        return true;
+    }
+
+    // O(1); returns false if the order is not resting (filled, cancelled, unknown)
+    bool cancelOrder(uint32_t id) {
+        if (id >= nodeOf.size() || nodeOf[id] == NONE) return false;
+        remove(nodeOf[id]);
+        return true;
+    }
+
+    int64_t bestBidPrice() const { return bestBid; }
+    int64_t bestAskPrice() const { return bestAsk; }
+    uint64_t quantityAt(Side side, uint32_t price) const {
+        return price > maxPrice ? 0 : (side == Side::Bid ? bidLevels[price] : askLevels[price]).quantity;
+    }
+    size_t restingOrders() const { return restingCount; }
+
+    void printOrderBook(int depth = 5) const {
+        cout << "\n====== LADDER BOOK ======" << endl;
+        cout << "--- BIDS (BUY) ---" << endl;
+        int64_t p = bestBid;
+        for (int i = 0; i < depth && p >= 0; i++, p = p ? bidPrices.prev(p - 1) : -1) {
+            cout << "$" << fixed << setprecision(2) << p / 100.0 << " x " << bidLevels[p].quantity << endl;
+        }
+        cout << "--- ASKS (SELL) ---" << endl;
+        p = bestAsk;
+        for (int i = 0; i < depth && p >= 0; i++, p = askPrices.next(p + 1)) {
+            cout << "$" << fixed << setprecision(2) << p / 100.0 << " x " << askLevels[p].quantity << endl;
+        }
+        cout << "=====================\n" << endl;
+    }
+};
+
+// Latency per operation: orders around a drifting mid price, ~1/3 cancels,
+// and marketable orders that cross the spread
+void benchmarkLadder(size_t operations) {
+    LadderOrderBook book(200000);
+    mt19937_64 rng(21);
+    vector<uint32_t> live;
+    vector<double> addNs, cancelNs, matchNs;
+    uint64_t filled = 0;
+    uint32_t nextId = 0;
+    int64_t mid = 100000;
+    for (size_t i = 0; i < operations; i++) {
+        uint64_t r = rng();
+        mid = min<int64_t>(max<int64_t>(mid + int64_t(r % 3) - 1, 1000), 199000);
+        if (r % 3 == 0 && !live.empty()) {
+            size_t k = (r >> 8) % live.size();
+            uint32_t id = live[k];
+            live[k] = live.back();
+            live.pop_back();
+            auto t0 = chrono::steady_clock::now();
+            book.cancelOrder(id);
+            cancelNs.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count());
+            continue;
+        }
+        Side side = (r >> 16) & 1 ? Side::Bid : Side::Ask;
+        bool marketable = (r >> 17) % 10 == 0;
+        int64_t offset = marketable ? -int64_t((r >> 20) % 20) : int64_t(1 + (r >> 20) % 50);
+        uint32_t price = uint32_t(side == Side::Bid ? mid - offset : mid + offset);
+        LimitOrder order{nextId++, price, uint32_t(1 + (r >> 40) % 500), side};
+        size_t fillsBefore = filled;
+        auto t0 = chrono::steady_clock::now();
+        book.addOrder(order, [&](const Fill& f) { filled += f.quantity ? 1 : 0; });
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count();
+        (filled > fillsBefore ? matchNs : addNs).push_back(ns);
+        live.push_back(order.id);
+    }
+    auto report = [](const char* name, vector<double>& v) {
+        if (v.empty()) return;
+        sort(v.begin(), v.end());
+        double mean = 0;
+        for (double x : v) mean += x;
+        cout << "  " << name << ": " << v.size() << " ops, mean " << fixed << setprecision(0) << mean / v.size()
+             << " ns, p50 " << v[v.size() / 2] << " ns, p99 " << v[size_t(v.size() * 0.99)] << " ns" << endl;
+    };
+    cout << "\n=== Ladder engine latency (" << operations << " operations, incl. ~20 ns timer overhead) ===" << endl;
+    report("add (rests)   ", addNs);
+    report("add (matches) ", matchNs);
+    report("cancel        ", cancelNs);
+    cout << "  resting orders at end: " << book.restingOrders() << endl;
+}
+
+// ---------------- Sharded multi-symbol engine and replay ----------------
+
+enum class EventType : uint8_t { Add, Cancel, Modify, Stop };
+
+// One market-data message. Order ids are dense and unique per symbol.
+struct OrderEvent {
+    EventType type;
+    Side side;
+    uint16_t symbol;
+    uint32_t orderId;
+    uint32_t price;
+    uint32_t quantity;
+};
+static_assert(sizeof(OrderEvent) == 16, "OrderEvent is a packed 16-byte record");
+
+// Binary event file: this header, then `count` OrderEvent records
+struct EventFileHeader {
+    char magic[8];  // "ORDEVT01"
+    uint64_t count;
+};
+
+void writeEventFile(const string& path, const vector<OrderEvent>& events) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) throw runtime_error("Cannot create event file: " + path);
+    EventFileHeader header;
+    memcpy(header.magic, "ORDEVT01", 8);
+    header.count = events.size();
+    bool ok = fwrite(&header, sizeof header, 1, f) == 1 &&
+              fwrite(events.data(), sizeof(OrderEvent), events.size(), f) == events.size();
+    fclose(f);
+    if (!ok) throw runtime_error("Short write to event file: " + path);
+}
+
+vector<OrderEvent> readEventFile(const string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) throw runtime_error("Cannot open event file: " + path);
+    EventFileHeader header;
+    if (fread(&header, sizeof header, 1, f) != 1 || memcmp(header.magic, "ORDEVT01", 8) != 0) {
+        fclose(f);
+        throw runtime_error("Not an order event file: " + path);
+    }
+    vector<OrderEvent> events(header.count);
+    size_t got = fread(events.data(), sizeof(OrderEvent), events.size(), f);
+    fclose(f);
+    if (got != events.size()) throw runtime_error("Truncated event file: " + path);
+    return events;
+}
+
+// Synthetic feed: per-symbol random walk, ~55% adds, 35% cancels, 10% modifies
+vector<OrderEvent> makeEvents(size_t count, uint16_t symbols, uint32_t maxPrice) {
+    mt19937_64 rng(22);
+    vector<int64_t> mid(symbols, maxPrice / 2);
+    vector<uint32_t> nextId(symbols, 0);
+    vector<vector<uint32_t>> live(symbols);
+    vector<OrderEvent> events;
+    events.reserve(count);
+    while (events.size() < count) {
+        uint64_t r = rng();
+        uint16_t sym = uint16_t(r % symbols);
+        mid[sym] = min<int64_t>(max<int64_t>(mid[sym] + int64_t((r >> 16) % 3) - 1, 100), maxPrice - 100);
+        Side side = (r >> 18) & 1 ? Side::Bid : Side::Ask;
+        int64_t offset = (r >> 19) % 10 == 0 ? -int64_t((r >> 23) % 10) : int64_t(1 + (r >> 23) % 40);
+        uint32_t price = uint32_t(side == Side::Bid ? mid[sym] - offset : mid[sym] + offset);
+        uint32_t qty = uint32_t(1 + (r >> 32) % 500);
+        uint32_t kind = (r >> 48) % 100;
+        auto& ids = live[sym];
+        if (kind < 45 && !ids.empty()) {
+            size_t k = (r >> 8) % ids.size();
+            if (kind < 35) {
+                events.push_back({EventType::Cancel, side, sym, ids[k], 0, 0});
+                ids[k] = ids.back();
+                ids.pop_back();
+            } else {
+                events.push_back({EventType::Modify, side, sym, ids[k], price, qty});
+            }
+        } else {
+            events.push_back({EventType::Add, side, sym, nextId[sym], price, qty});
+            ids.push_back(nextId[sym]++);
+        }
+    }
+    return events;
+}
+
+// Lamport single-producer/single-consumer ring with cached peer indices
+template <typename T>
+class SpscQueue {
+private:
+    vector<T> buffer;
+    size_t mask;
+    alignas(64) atomic<size_t> head{0};  // consumer position
+    size_t cachedTail = 0;
+    alignas(64) atomic<size_t> tail{0};  // producer position
+    size_t cachedHead = 0;
+
+public:
+    SpscQueue(size_t capacity) {
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        buffer.resize(cap);
+        mask = cap - 1;
+    }
+
+    bool push(const T& item) {
+        size_t t = tail.load(memory_order_relaxed);
+        if (t - cachedHead > mask) {
+            cachedHead = head.load(memory_order_acquire);
+            if (t - cachedHead > mask) return false;
+        }
+        buffer[t & mask] = item;
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        size_t h = head.load(memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(memory_order_acquire);
+            if (h == cachedTail) return false;
+        }
+        item = buffer[h & mask];
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+};
+
+// Applies one event to its symbol's book; false if the book rejected it
+// (duplicate add id, or cancel/modify of an order no longer resting).
+template <typename OnFill>
+bool applyEvent(LadderOrderBook& book, const OrderEvent& e, OnFill&& onFill) {
+    try {
+        if (e.type == EventType::Add) book.addOrder({e.orderId, e.price, e.quantity, e.side}, onFill);
+        else if (e.type == EventType::Cancel) return book.cancelOrder(e.orderId);
+        else return book.modifyOrder(e.orderId, e.price, e.quantity, onFill);
+    } catch (const exception&) {
+        return false;
+    }
+    return true;
+}
+
+// Order-sensitive FNV-1a style fold of one fill into its symbol's checksum
+const uint64_t FILL_CHECKSUM_SEED = 0xcbf29ce484222325ULL;
+
+void foldFill(uint64_t& checksum, const Fill& f) {
+    checksum = (checksum ^ (uint64_t(f.bidId) << 32 | f.askId)) * 0x100000001b3ULL;
+    checksum = (checksum ^ (uint64_t(f.price) << 32 | f.quantity)) * 0x100000001b3ULL;
+}
+
+// Reference run: every symbol's events in feed order on one thread
+vector<uint64_t> sequentialFillChecksums(const vector<OrderEvent>& events, uint16_t symbols, uint32_t maxPrice) {
+    vector<unique_ptr<LadderOrderBook>> books(symbols);
+    vector<uint64_t> checksums(symbols, FILL_CHECKSUM_SEED);
+    for (const auto& e : events) {
+        if (!books[e.symbol]) books[e.symbol] = make_unique<LadderOrderBook>(maxPrice);
+        applyEvent(*books[e.symbol], e, [&](const Fill& f) { foldFill(checksums[e.symbol], f); });
+    }
+    return checksums;
+}
+
+// Book-per-symbol engine. Symbols hash to shards; each shard is one worker
+// thread (pinned to a core on Linux) that owns its books outright and is
+// fed through its own SPSC queue, so the matching path takes no locks.
+// Fills and per-operation latencies are recorded in shard-local buffers
+// and reported after the run.
+class ShardedMatchingEngine {
+private:
+    struct alignas(64) Shard {
+        SpscQueue<OrderEvent> queue;
+        vector<unique_ptr<LadderOrderBook>> books;  // by symbol; only this shard's symbols
+        vector<uint32_t> latencyNs[3];              // Add, Cancel, Modify
+        vector<Fill> fills;
+        vector<uint64_t> fillChecksums;             // by symbol, see foldFill
+        uint64_t volume = 0;
+        uint64_t unknown = 0;  // rejected: duplicate add id, or cancel/modify of an order no longer resting
+        thread worker;
+
+        Shard(size_t capacity) : queue(capacity) {}
+    };
+
+    vector<unique_ptr<Shard>> shards;
+
+    void run(Shard& shard) {
+        OrderEvent e;
+        auto onFill = [&](const Fill& f) {
+            shard.fills.push_back(f);
+            shard.volume += f.quantity;
+            foldFill(shard.fillChecksums[e.symbol], f);
+        };
+        while (true) {
+            if (!shard.queue.pop(e)) {
+                this_thread::yield();
+                continue;
+            }
+            if (e.type == EventType::Stop) return;
+            LadderOrderBook& book = *shard.books[e.symbol];
+            auto t0 = chrono::steady_clock::now();
+            bool ok = applyEvent(book, e, onFill);
+            auto t1 = chrono::steady_clock::now();
+            shard.latencyNs[int(e.type)].push_back(uint32_t(chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count()));
+            shard.unknown += !ok;
+        }
+    }
+
+public:
+    ShardedMatchingEngine(int shardCount, uint16_t symbols, uint32_t maxPrice, size_t queueCapacity = 1 << 16) {
+        if (shardCount <= 0) throw invalid_argument("Shard count must be positive.");
+        for (int i = 0; i < shardCount; i++) {
+            shards.push_back(make_unique<Shard>(queueCapacity));
+            shards.back()->books.resize(symbols);
+            shards.back()->fillChecksums.assign(symbols, FILL_CHECKSUM_SEED);
+        }
+        for (uint16_t s = 0; s < symbols; s++) {
+            shards[shardOf(s)]->books[s] = make_unique<LadderOrderBook>(maxPrice);
+        }
+    }
+
+    ~ShardedMatchingEngine() {
+        finish();
+    }
+
+    size_t shardOf(uint16_t symbol) const {
+        return size_t((uint32_t(symbol) * 0x9E3779B1u) >> 8) % shards.size();
+    }
+
+    void start() {
+        unsigned cores = max(1u, thread::hardware_concurrency());
+        for (size_t i = 0; i < shards.size(); i++) {
+            Shard& shard = *shards[i];
+            shard.worker = thread(&ShardedMatchingEngine::run, this, ref(shard));
+#ifdef __linux__
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(i % cores, &set);
+            pthread_setaffinity_np(shard.worker.native_handle(), sizeof set, &set);
+#endif
+        }
+    }
+
+    void submit(const OrderEvent& e) {
+        if (e.symbol >= shards[0]->books.size()) throw out_of_range("Unknown symbol.");
+        SpscQueue<OrderEvent>& queue = shards[shardOf(e.symbol)]->queue;
+        while (!queue.push(e)) this_thread::yield();
+    }
+
+    // Drains the queues and joins the workers
+    void finish() {
+        for (auto& shard : shards) {
+            if (!shard->worker.joinable()) continue;
+            OrderEvent stop{EventType::Stop, Side::Bid, 0, 0, 0, 0};
+            while (!shard->queue.push(stop)) this_thread::yield();
+            shard->worker.join();
+        }
+    }
+
+    // Per-symbol fill checksums, each taken from the shard owning the symbol
+    vector<uint64_t> fillChecksums() const {
+        vector<uint64_t> checksums(shards[0]->books.size());
+        for (size_t s = 0; s < checksums.size(); s++) {
+            checksums[s] = shards[shardOf(uint16_t(s))]->fillChecksums[s];
+        }
+        return checksums;
+    }
+
+    void report(double seconds, size_t events) const {
+        static const char* names[3] = {"add   ", "cancel", "modify"};
+        uint64_t fills = 0, volume = 0, unknown = 0;
+        for (const auto& shard : shards) {
+            fills += shard->fills.size();
+            volume += shard->volume;
+            unknown += shard->unknown;
+        }
+        cout << "  " << shards.size() << " shard(s): " << fixed << setprecision(2) << events / seconds / 1e6
+             << " M events/s, " << fills << " fills, volume " << volume << ", " << unknown
+             << " rejected events (duplicate ids, orders already gone)" << endl;
+        for (int type = 0; type < 3; type++) {
+            vector<uint32_t> all;
+            for (const auto& shard : shards) {
+                all.insert(all.end(), shard->latencyNs[type].begin(), shard->latencyNs[type].end());
+            }
+            if (all.empty()) continue;
+            auto pick = [&](double q) {
+                auto it = all.begin() + size_t(q * (all.size() - 1));
+                nth_element(all.begin(), it, all.end());
+                return *it;
+            };
+            cout << "    " << names[type] << " p50 " << pick(0.5) << " ns, p99 " << pick(0.99) << " ns, p99.9 "
+                 << pick(0.999) << " ns (" << all.size() << " ops)" << endl;
+        }
+    }
+};
+
+uint16_t symbolCount(const vector<OrderEvent>& events) {
+    uint16_t symbols = 0;
+    for (const auto& e : events) symbols = max<uint16_t>(symbols, uint16_t(e.symbol + 1));
+    return symbols;
+}
+
+// Replays events as fast as the shards accept them and reports throughput
+// plus per-operation service latency (timer overhead included). Each
+// symbol's fills are then checked against `expected`, the checksums of
+// sequentialFillChecksums(), since sharding must not change any book.
+void replay(const vector<OrderEvent>& events, uint32_t maxPrice, int shardCount, const vector<uint64_t>& expected) {
+    ShardedMatchingEngine engine(shardCount, symbolCount(events), maxPrice);
+    engine.start();
+    auto t0 = chrono::steady_clock::now();
+    for (const auto& e : events) engine.submit(e);
+    engine.finish();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    engine.report(seconds, events.size());
+
+    vector<uint64_t> actual = engine.fillChecksums();
+    size_t mismatched = 0;
+    for (size_t s = 0; s < actual.size(); s++) mismatched += actual[s] != expected[s];
+    if (mismatched == 0) cout << "    fills match sequential per-symbol processing" << endl;
+    else cout << "    MISMATCH: " << mismatched << " symbol(s) differ from sequential processing" << endl;
+}
+
+int main(int argc, char** argv) {
+    // Usage: --generate <file> [events] [symbols]  |  --replay <file> [shards]  |  --benchmark
+    const uint32_t replayMaxPrice = 20000;
+    bool benchmarkRun = argc > 1 && string(argv[1]) == "--benchmark";
+    try {
+        if (argc > 2 && string(argv[1]) == "--generate") {
+            size_t count = argc > 3 ? stoull(argv[3]) : 10000000;
+            uint16_t symbols = uint16_t(argc > 4 ? stoi(argv[4]) : 64);
+            writeEventFile(argv[2], makeEvents(count, symbols, replayMaxPrice));
+            cout << "Wrote " << count << " events for " << symbols << " symbols to " << argv[2] << endl;
+            return 0;
+        }
+        if (argc > 2 && string(argv[1]) == "--replay") {
+            vector<OrderEvent> events = readEventFile(argv[2]);
+            int shardCount = argc > 3 ? stoi(argv[3]) : int(max(1u, thread::hardware_concurrency()));
+            cout << "Replaying " << events.size() << " events from " << argv[2] << endl;
+            replay(events, replayMaxPrice, shardCount,
+                   sequentialFillChecksums(events, symbolCount(events), replayMaxPrice));
+            return 0;
+        }
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+
     OrderBook orderBook;
     int order_id = 1;
 
@@ -203,5 +875,32 @@ int main() {
 
     orderBook.printOrderBook();
 
+    // Same flow on the price ladder: prices in cents, fills via callback
+    cout << "=== PRICE-LADDER ENGINE ===" << endl;
+    LadderOrderBook ladder(100000);
+    auto onFill = [](const Fill& f) {
+        cout << "TRADE: BID #" << f.bidId << " x ASK #" << f.askId << " | $" << fixed << setprecision(2)
+             << f.price / 100.0 << " x " << f.quantity << endl;
+    };
+    ladder.addOrder({1, 15025, 100, Side::Bid}, onFill);
+    ladder.addOrder({2, 14950, 200, Side::Bid}, onFill);
+    ladder.addOrder({3, 15100, 150, Side::Ask}, onFill);
+    ladder.addOrder({4, 15000, 300, Side::Ask}, onFill);
+    ladder.addOrder({5, 15050, 250, Side::Bid}, onFill);
+    ladder.addOrder({6, 15000, 400, Side::Bid}, onFill);
+    ladder.addOrder({7, 15200, 100, Side::Ask}, onFill);
+    ladder.addOrder({8, 14875, 150, Side::Bid}, onFill);
+    ladder.cancelOrder(2);
+    ladder.printOrderBook();
+
+    if (!benchmarkRun) return 0;
+    benchmarkLadder(5000000);
+
+    cout << "\n=== Sharded replay (4M synthetic events, 64 symbols) ===" << endl;
+    vector<OrderEvent> events = makeEvents(4000000, 64, replayMaxPrice);
+    vector<uint64_t> expected = sequentialFillChecksums(events, symbolCount(events), replayMaxPrice);
+    for (int shardCount : {1, 2, 4}) {
+        replay(events, replayMaxPrice, shardCount, expected);
+    }
     return 0;
 }
\ No newline at end of file
@@ -1,11 +1,13 @@
 #include <iostream>
 #include <vector>
 #include <iomanip>
+#include <limits>
 using namespace std;
 
+template <typename T = int>
 class MinHeap {
 private:
-    vector<int> heap;
+    vector<T> heap;
 
     int parent(int i) { return (i - 1) / 2; }
     int left(int i) { return (2 * i + 1); }
@@ -36,19 +38,19 @@ private:
 public:
     MinHeap() {}
 
-    int getMin() {
+    T getMin() {
         if (heap.empty()) {
             throw runtime_error("Heap is empty");
         }
         return heap[0];
     }
 
-    void insert(int key) {
+    void insert(const T& key) {
         heap.push_back(key);
         heapifyUp(heap.size() - 1);
     }
 
-    void decreaseKey(int i, int new_val) {
+    void decreaseKey(int i, const T& new_val) {
         if (i >= heap.size())
             throw out_of_range("Index out of range");
 
@@ -56,17 +58,17 @@ public:
         heapifyUp(i);
     }
 
-    int extractMin() {
+    T extractMin() {
         if (heap.empty())
             throw runtime_error("Heap is empty");
 
         if (heap.size() == 1) {
-            int root = heap[0];
+            T root = heap[0];
             heap.pop_back();
             return root;
         }
 
-        int root = heap[0];
+        T root = heap[0];
         heap[0] = heap.back();
         heap.pop_back();
         heapifyDown(0);
@@ -78,7 +80,7 @@ public:
         if (i >= heap.size())
             throw out_of_range("Index out of range");
 
-        decreaseKey(i, INT_MIN);
+        decreaseKey(i, numeric_limits<T>::lowest());
         extractMin();
     }
 
@@ -98,7 +100,7 @@ public:
     }
 
     void printArray() {
-        for (int val : heap)
+        for (const T& val : heap)
             cout << val << " ";
         cout << endl;
     }
@@ -1,38 +1,126 @@
 #include <iostream>
 #include <vector>
-#include <cmath>
-#include <limits>
 #include <iomanip>
-#include <sstream>
-#include <queue>
 #include <algorithm>
-#include <set> // Include the set header
-#include <stdexcept> // For exceptions
-
-// Define a structure for a node in the Fibonacci heap
-struct FibonacciNode {
-    int key;             // The key (priority) of the node
-    FibonacciNode* parent;          // Pointer to the parent node
-    FibonacciNode* child;           // Pointer to an arbitrary child node
-    FibonacciNode* left;            // Pointer to the left sibling
-    FibonacciNode* right;           // Pointer to the right sibling
-    int degree;            // The number of children of this node
-    bool mark;             // A boolean indicating if this node has lost a child
-    void* data;            // A generic pointer to store any kind of data (optional)
-
-    // Constructor for the FibonacciNode
-    FibonacciNode(int k) : key(k), parent(nullptr), child(nullptr), left(this), right(this), degree(0), mark(false), data(nullptr) {} // Initialize left/right to self
-};
-
-// Class for the Fibonacci Heap
+#include <functional> // For std::less
+#include <memory>     // For std::unique_ptr (node pool chunks)
+#include <utility>    // For std::pair
+#include <cstdint>
+#include <random>
+#include <chrono>
+#include <stdexcept>  // For exceptions
+#include <string>
+
+// Class template for the Fibonacci Heap.
+// Key:     the priority; the node that compares smallest under Compare is the minimum
+// Value:   payload carried alongside the key (e.g. a vertex id)
+// Compare: strict weak ordering on keys (std::less<Key> gives a min-heap)
+template <typename Key, typename Value = int, typename Compare = std::less<Key>>
 class FibonacciHeap {
+public:
+    // Stable reference to an inserted element, returned by insert().
+    // It stays valid until the element is extracted or deleted; after that the
+    // slot's generation changes, so a stale handle is detected instead of
+    // silently aliasing whatever element reuses the slot.
+    struct Handle {
+        uint32_t index;
+        uint32_t generation;
+    };
+
 private:
-    FibonacciNode* minNode;         // Pointer to the node with the minimum key in the heap
-    int nodeCount;           // The total number of nodes in the heap
+    // Structure for a node in the Fibonacci heap
+    struct Node {
+        Key key;               // The key (priority) of the node
+        Value value;           // The payload stored with the key
+        Node* parent;          // Pointer to the parent node
+        Node* child;           // Pointer to an arbitrary child node
+        Node* left;            // Pointer to the left sibling
+        Node* right;           // Pointer to the right sibling (next free node while pooled)
+        int degree;            // The number of children of this node
+        bool mark;             // A boolean indicating if this node has lost a child
+        bool inHeap;           // False while the node sits on the free list
+        uint32_t index;        // Position of the node in the pool (for handles)
+        uint32_t generation;   // Bumped each time the node is released
+    };
+
+    // Nodes are allocated in fixed-size chunks, so their addresses never move and
+    // the pointer-based tree links stay valid as the pool grows. Released nodes go
+    // on a free list and are reused by later inserts, so a long-running heap
+    // (e.g. Dijkstra over many sources) stops calling the allocator altogether.
+    static const uint32_t CHUNK_BITS = 10;
+    static const uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+
+    std::vector<std::unique_ptr<Node[]>> chunks;
+    uint32_t poolSize;      // Nodes handed out from the chunks so far
+    Node* freeList;         // Singly linked through Node::right
+
+    Node* minNode;          // Pointer to the node with the minimum key in the heap
+    int nodeCount;          // The total number of nodes in the heap
+    Compare comp;
+
+    // Scratch space for consolidate, kept across calls to avoid reallocating
+    std::vector<Node*> degreeTable;
+    std::vector<Node*> roots;
+
+    Node* nodeAt(uint32_t index) const {
+        return &chunks[index >> CHUNK_BITS][index & (CHUNK_SIZE - 1)];
+    }
+
+    Node* allocateNode(const Key& key, const Value& value) {
+        Node* node;
+        if (freeList != nullptr) {
+            node = freeList;
+            freeList = node->right;
+        } else {
+            if ((poolSize & (CHUNK_SIZE - 1)) == 0) {
+                chunks.emplace_back(new Node[CHUNK_SIZE]);
+            }
+            node = nodeAt(poolSize);
+            node->index = poolSize++;
+            node->generation = 0;
+        }
+        node->key = key;
+        node->value = value;
+        node->parent = nullptr;
+        node->child = nullptr;
+        node->left = node;     // A new node forms a circular list on its own
+        node->right = node;
+        node->degree = 0;
+        node->mark = false;
+        node->inHeap = true;
+        return node;
+    }
+
+    void releaseNode(Node* node) {
+        node->inHeap = false;
+        node->generation++;    // Invalidates every outstanding handle to this node
+        node->right = freeList;
+        freeList = node;
+    }
+
+    // Resolves a handle, throwing if it is stale or was never issued by this heap
+    Node* resolve(Handle handle) const {
+        if (handle.index >= poolSize) {
+            throw std::out_of_range("Handle does not belong to this heap.");
+        }
+        Node* node = nodeAt(handle.index);
+        if (!node->inHeap || node->generation != handle.generation) {
+            throw std::out_of_range("Handle refers to an element that is no longer in the heap.");
+        }
+        return node;
+    }
+
+    // Adds a detached node to the root list (next to minNode)
+    void addToRootList(Node* node) {
+        node->left = minNode;
+        node->right = minNode->right;
+        minNode->right->left = node;
+        minNode->right = node;
+    }
 
     // Helper function to link two nodes (used in consolidate)
     // Makes y a child of x
-    void linkNodes(FibonacciNode* y, FibonacciNode* x) {
+    void linkNodes(Node* y, Node* x) {
         // Remove y from the root list
         y->left->right = y->right;
         y->right->left = y->left;
@@ -59,33 +147,26 @@ private:
     void consolidate() {
         if (minNode == nullptr) return;
 
-        // Max degree is bounded by O(log n)
-        // Need a size slightly larger due to potential degree increase during linking
-        int maxDegree = static_cast<int>(floor(log2(nodeCount))) + 2; // +2 for safety margin
-        std::vector<FibonacciNode*> degreeTable(maxDegree, nullptr);
-
         // Collect root nodes to iterate safely without modifying the list during iteration
-        std::vector<FibonacciNode*> roots;
-        FibonacciNode* current = minNode;
-        if (current != nullptr) {
-            do {
-                roots.push_back(current);
-                current = current->right;
-            } while (current != minNode);
-        }
+        roots.clear();
+        Node* current = minNode;
+        do {
+            roots.push_back(current);
+            current = current->right;
+        } while (current != minNode);
 
-        // Iterate through the collected root nodes
-        for (FibonacciNode* node : roots) {
-            // Ensure the node is actually part of the root list before processing
-            // (It might have become a child during previous linking steps)
-            if (node->parent != nullptr) continue;
+        // Max degree is bounded by O(log n); the table only grows if a degree
+        // beyond its current size shows up
+        std::fill(degreeTable.begin(), degreeTable.end(), nullptr);
 
+        // Iterate through the collected root nodes
+        for (Node* node : roots) {
             int d = node->degree;
-            while (d < degreeTable.size() && degreeTable[d] != nullptr) {
-                FibonacciNode* y = degreeTable[d];
+            while (d < static_cast<int>(degreeTable.size()) && degreeTable[d] != nullptr) {
+                Node* y = degreeTable[d];
 
                 // Ensure node has the smaller key, swap if necessary
-                if (node->key > y->key) {
+                if (comp(y->key, node->key)) {
                     std::swap(node, y);
                 }
 
@@ -95,52 +176,33 @@ private:
                 // Clear the degree table entry and increment degree for the next check
                 degreeTable[d] = nullptr;
                 d++;
-                 // Resize degreeTable if needed (should be rare with initial sizing)
-                if (d >= degreeTable.size()) {
-                    degreeTable.resize(d + 1, nullptr);
-                }
             }
-             // Ensure d is within bounds before assignment
-            if (d < degreeTable.size()) {
-                degreeTable[d] = node;
-            } else {
-                 // Handle resize case if d went out of bounds during while loop
-                 degreeTable.resize(d + 1, nullptr);
-                 degreeTable[d] = node;
+            if (d >= static_cast<int>(degreeTable.size())) {
+                degreeTable.resize(d + 1, nullptr);
             }
+            degreeTable[d] = node;
         }
 
         // Rebuild the root list from the degree table and find the new minimum
         minNode = nullptr;
-        for (int i = 0; i < degreeTable.size(); ++i) {
-            if (degreeTable[i] != nullptr) {
-                FibonacciNode* rootNode = degreeTable[i];
-                // Ensure node is detached from any potential parent (should be already)
-                rootNode->parent = nullptr;
-                // Ensure left/right point to self before adding to root list
+        for (Node* rootNode : degreeTable) {
+            if (rootNode == nullptr) continue;
+            if (minNode == nullptr) {
                 rootNode->left = rootNode;
                 rootNode->right = rootNode;
-
-                if (minNode == nullptr) {
+                minNode = rootNode;
+            } else {
+                addToRootList(rootNode);
+                // Update minNode if necessary
+                if (comp(rootNode->key, minNode->key)) {
                     minNode = rootNode;
-                } else {
-                    // Add rootNode to the root list (circular doubly linked)
-                    rootNode->right = minNode->right;
-                    rootNode->left = minNode;
-                    minNode->right->left = rootNode;
-                    minNode->right = rootNode;
-
-                    // Update minNode if necessary
-                    if (rootNode->key < minNode->key) {
-                        minNode = rootNode;
-                    }
                 }
             }
         }
     }
 
     // Helper function to cut a node from its parent and add it to the root list
-    void cut(FibonacciNode* node, FibonacciNode* parent) {
+    void cut(Node* node, Node* parent) {
         // Remove node from the child list of parent
         if (node->right == node) { // node is the only child
             parent->child = nullptr;
@@ -154,84 +216,32 @@ private:
         parent->degree--;
 
         // Add node to the root list
-        node->left = minNode;
-        node->right = minNode->right;
-        minNode->right->left = node;
-        minNode->right = node;
+        addToRootList(node);
 
         node->parent = nullptr;
         node->mark = false; // Node becomes a root, mark is cleared
     }
 
-    // Helper function for cascading cut
-    void cascadingCut(FibonacciNode* node) {
-        FibonacciNode* parent = node->parent;
-        if (parent != nullptr) {
+    // Helper function for cascading cut: walks up while ancestors are marked,
+    // cutting each one, and marks the first unmarked non-root ancestor
+    void cascadingCut(Node* node) {
+        Node* parent = node->parent;
+        while (parent != nullptr) {
             if (!node->mark) {
                 // If node is not marked, mark it (it lost a child)
                 node->mark = true;
-            } else {
-                // If node is marked, it means it already lost a child before.
-                // Cut it from its parent and perform cascading cut on the parent.
-                cut(node, parent);
-                cascadingCut(parent);
+                return;
             }
+            // If node is marked, it means it already lost a child before.
+            // Cut it from its parent and continue with the parent.
+            cut(node, parent);
+            node = parent;
+            parent = node->parent;
         }
     }
 
-    // Helper function to find a node by key (robust traversal)
-    FibonacciNode* findNode(int key) {
-        if (minNode == nullptr) return nullptr;
-
-        std::queue<FibonacciNode*> q;
-        std::set<FibonacciNode*> visited;
-
-        // Add all root nodes to the queue initially
-        FibonacciNode* currentRoot = minNode;
-        do {
-            if (visited.find(currentRoot) == visited.end()) {
-                 q.push(currentRoot);
-                 visited.insert(currentRoot);
-            } else {
-                // Avoid infinite loop if root list is corrupted
-                break;
-            }
-            currentRoot = currentRoot->right;
-        } while (currentRoot != minNode);
-
-
-        while (!q.empty()) {
-            FibonacciNode* current = q.front();
-            q.pop();
-
-            if (current->key == key) {
-                return current; // Found the node
-            }
-
-            // Add children to the queue
-            FibonacciNode* child = current->child;
-            if (child != nullptr) {
-                FibonacciNode* startChild = child;
-                do {
-                    if (visited.find(child) == visited.end()) {
-                        q.push(child);
-                        visited.insert(child);
-                    } else {
-                        // Avoid infinite loop if child list is corrupted
-                        break;
-                    }
-                    child = child->right;
-                } while (child != startChild);
-            }
-        }
-
-        return nullptr; // Node not found
-    }
-
     // Helper function to print a single tree structure recursively
-    void printSingleTree(FibonacciNode* node, int indent, std::ostream& out) const {
-         if (node == nullptr) return;
-
+    void printSingleTree(const Node* node, int indent, std::ostream& out) const {
          // Print the current node
          out << std::setw(indent) << "" << node->key;
          if (node->mark) {
@@ -243,9 +253,9 @@ private:
          out << std::endl;
 
          // Recursively print children
-         FibonacciNode* child = node->child;
+         const Node* child = node->child;
          if (child != nullptr) {
-             FibonacciNode* start = child;
+             const Node* start = child;
              do {
                  printSingleTree(child, indent + 4, out); // Increase indent for children
                  child = child->right;
@@ -256,67 +266,72 @@ private:
 
 public:
     // Constructor for the Fibonacci Heap
-    FibonacciHeap() : minNode(nullptr), nodeCount(0) {}
+    explicit FibonacciHeap(const Compare& compare = Compare())
+        : poolSize(0), freeList(nullptr), minNode(nullptr), nodeCount(0), comp(compare) {}
 
-    // Function to insert a new node with a given key
-    void insert(int key) {
-        FibonacciNode* newNode = new FibonacciNode(key);
-        // newNode->left and newNode->right are already initialized to self
+    // Nodes point into this heap's pool, so the heap is neither copied nor moved
+    FibonacciHeap(const FibonacciHeap&) = delete;
+    FibonacciHeap& operator=(const FibonacciHeap&) = delete;
+
+    // Function to insert a new element; returns a handle for decreaseKey/deleteNode
+    Handle insert(const Key& key, const Value& value = Value()) {
+        Node* newNode = allocateNode(key, value);
 
         if (minNode == nullptr) {
             minNode = newNode;
         } else {
             // Insert newNode into the root list (next to minNode)
-            newNode->right = minNode->right;
-            newNode->left = minNode;
-            minNode->right->left = newNode;
-            minNode->right = newNode;
+            addToRootList(newNode);
 
             // Update minNode if the new node is smaller
-            if (newNode->key < minNode->key) {
+            if (comp(newNode->key, minNode->key)) {
                 minNode = newNode;
             }
         }
         nodeCount++;
+        return {newNode->index, newNode->generation};
     }
 
     // Function to get the minimum key
-    int getMin() const {
+    const Key& getMin() const {
         if (minNode == nullptr) {
             throw std::runtime_error("Heap is empty. Cannot get minimum.");
         }
         return minNode->key;
     }
 
-    // Function to extract the minimum node
-    int extractMin() {
+    // Function to get the value stored with the minimum key
+    const Value& getMinValue() const {
+        if (minNode == nullptr) {
+            throw std::runtime_error("Heap is empty. Cannot get minimum.");
+        }
+        return minNode->value;
+    }
+
+    // Function to extract the minimum element, returning its key and value
+    std::pair<Key, Value> extractMinEntry() {
         if (minNode == nullptr) {
              throw std::runtime_error("Heap is empty. Cannot extract minimum.");
         }
-        FibonacciNode* extractedMin = minNode;
-        int minValue = extractedMin->key;
+        Node* extractedMin = minNode;
+        std::pair<Key, Value> entry(extractedMin->key, extractedMin->value);
 
         // 1. Add children of the minimum node to the root list
         if (extractedMin->child != nullptr) {
-            FibonacciNode* child = extractedMin->child;
-            FibonacciNode* startChild = child;
+            Node* child = extractedMin->child;
             do {
-                FibonacciNode* nextChild = child->right; // Store next before modifying list
-
-                // Remove child from its sibling list (which is the child list of extractedMin)
-                child->left->right = child->right;
-                child->right->left = child->left;
-
-                // Add child to the root list
-                child->left = minNode;
-                child->right = minNode->right;
-                minNode->right->left = child;
-                minNode->right = child;
-
                 child->parent = nullptr; // Child becomes a root
-
-                child = nextChild;
-            } while (child != startChild); // Use startChild to detect end of circular list
+                child = child->right;
+            } while (child != extractedMin->child);
+
+            // Splice the whole child list into the root list in O(1)
+            Node* childLast = extractedMin->child->left;
+            Node* afterMin = minNode->right;
+            minNode->right = extractedMin->child;
+            extractedMin->child->left = minNode;
+            childLast->right = afterMin;
+            afterMin->left = childLast;
+            extractedMin->child = nullptr;
         }
 
         // 2. Remove extractedMin from the root list
@@ -332,64 +347,67 @@ public:
         }
 
         nodeCount--;
-        delete extractedMin; // Free the memory of the extracted node
-        return minValue;
+        releaseNode(extractedMin); // Return the node to the pool
+        return entry;
     }
 
-    // Function to decrease the key of a node
-    void decreaseKey(int oldKey, int newKey) {
-        if (newKey > oldKey) { // Note: Allow newKey == oldKey, though it does nothing
-             throw std::invalid_argument("New key must be smaller than or equal to the old key.");
-        }
+    // Function to extract the minimum node, returning its key
+    Key extractMin() {
+        return extractMinEntry().first;
+    }
 
-        FibonacciNode* targetNode = findNode(oldKey);
+    // Function to decrease the key of the element behind a handle (amortized O(1))
+    void decreaseKey(Handle handle, const Key& newKey) {
+        Node* targetNode = resolve(handle);
 
-        if (targetNode == nullptr) {
-            throw std::runtime_error("Node with the specified old key not found.");
+        if (comp(targetNode->key, newKey)) {
+             throw std::invalid_argument("New key must be smaller than or equal to the old key.");
         }
 
-        // If new key is not actually smaller, do nothing
-        if (newKey == oldKey) return;
-
         targetNode->key = newKey;
-        FibonacciNode* parent = targetNode->parent;
+        Node* parent = targetNode->parent;
 
         // If the heap property is violated (node < parent)
-        if (parent != nullptr && targetNode->key < parent->key) {
+        if (parent != nullptr && comp(targetNode->key, parent->key)) {
             cut(targetNode, parent);    // Cut the node from its parent
             cascadingCut(parent);   // Perform cascading cuts upwards
         }
 
         // Update the overall minimum pointer if necessary
-        if (targetNode->key < minNode->key) {
+        if (comp(targetNode->key, minNode->key)) {
             minNode = targetNode;
         }
     }
 
-    // Function to delete a node with a given key
-    void deleteNode(int key) {
-         if (minNode == nullptr) {
-             throw std::runtime_error("Heap is empty. Cannot delete node.");
-         }
+    // Function to delete the element behind a handle.
+    // Instead of decreasing the key to a sentinel "minus infinity" (which
+    // requires Key to have one), the node is cut to the root list and made
+    // the minimum directly, then extracted.
+    void deleteNode(Handle handle) {
+        Node* targetNode = resolve(handle);
 
-         // To delete, we decrease the key to the minimum possible value
-         // and then extract the minimum.
-         try {
-             // Use a value guaranteed to be smaller than any other key
-             decreaseKey(key, std::numeric_limits<int>::min());
-
-             // Now the node to be deleted is the minimum node
-             extractMin();
-         } catch (const std::runtime_error& e) {
-             // Catch if decreaseKey couldn't find the node
-             std::cerr << "Error during delete: " << e.what() << std::endl;
-             // Re-throw or handle as appropriate
-             throw;
-         } catch (const std::invalid_argument& e) {
-              // Should not happen if INT_MIN is used, but handle just in case
-             std::cerr << "Error during delete (invalid key decrease): " << e.what() << std::endl;
-             throw;
-         }
+        Node* parent = targetNode->parent;
+        if (parent != nullptr) {
+            cut(targetNode, parent);
+            cascadingCut(parent);
+        }
+        minNode = targetNode;
+        extractMinEntry();
+    }
+
+    // Whether the handle still refers to an element in the heap
+    bool contains(Handle handle) const {
+        return handle.index < poolSize && nodeAt(handle.index)->inHeap &&
+               nodeAt(handle.index)->generation == handle.generation;
+    }
+
+    // Current key / value of the element behind a handle
+    const Key& key(Handle handle) const {
+        return resolve(handle)->key;
+    }
+
+    const Value& value(Handle handle) const {
+        return resolve(handle)->value;
     }
 
     // Function to print the Fibonacci heap (iterates through root list)
@@ -399,15 +417,8 @@ public:
             return;
         }
         out << "Fibonacci Heap (Root List):" << std::endl;
-        FibonacciNode* current = minNode;
-        std::set<FibonacciNode*> visitedRoots; // Avoid infinite loop
-
+        const Node* current = minNode;
         do {
-            if (visitedRoots.count(current)) {
-                 out << "  (Detected cycle in root list, stopping print)" << std::endl;
-                 break;
-            }
-            visitedRoots.insert(current);
             out << "--- Tree Rooted at " << current->key << " (Degree: " << current->degree << ") ---" << std::endl;
             printSingleTree(current, 2, out); // Print tree starting from this root
             current = current->right;
@@ -425,80 +436,89 @@ public:
         return minNode == nullptr; // More direct check
     }
 
-    // Destructor to free memory (using robust traversal)
-    ~FibonacciHeap() {
-        if (minNode == nullptr) return;
-
-        std::queue<FibonacciNode*> q;
-        std::set<FibonacciNode*> visited;
-        std::vector<FibonacciNode*> nodesToDelete; // Collect nodes first to avoid use-after-free
+    // Number of nodes ever taken from the pool (live nodes plus free list)
+    size_t poolCapacity() const {
+        return poolSize;
+    }
 
-        // Add all root nodes to the queue initially
-        FibonacciNode* currentRoot = minNode;
-         do {
-            if (visited.find(currentRoot) == visited.end()) {
-                 q.push(currentRoot);
-                 visited.insert(currentRoot);
-            } else {
-                // Break if cycle detected during initial root scan
-                break;
-            }
-            currentRoot = currentRoot->right;
-        } while (currentRoot != minNode);
-
-
-        while (!q.empty()) {
-            FibonacciNode* current = q.front();
-            q.pop();
-            nodesToDelete.push_back(current); // Add node to the delete list
-
-            // Add children to the queue
-            FibonacciNode* child = current->child;
-            if (child != nullptr) {
-                FibonacciNode* startChild = child;
-                do {
-                    if (visited.find(child) == visited.end()) {
-                        q.push(child);
-                        visited.insert(child);
-                    } else {
-                         // Break if cycle detected in child list traversal
-                         break;
-                    }
-                    child = child->right;
-                } while (child != startChild);
-            }
-        }
+    // The pool owns every node, so the destructor has nothing to walk:
+    // releasing the chunks frees the whole heap at once.
+    ~FibonacciHeap() = default;
+};
 
-        // Now delete all collected nodes
-        for (FibonacciNode* node : nodesToDelete) {
-            delete node;
-        }
+// Benchmark: a Dijkstra-like workload where most operations are decreaseKey.
+// Inserts n keys, then performs `decreases` random decreaseKey calls through
+// handles, then drains the heap and checks the output is sorted.
+void benchmarkDecreaseKey(int n, int decreases) {
+    std::mt19937_64 rng(23);
+    FibonacciHeap<uint64_t, int> heap;
+    std::vector<FibonacciHeap<uint64_t, int>::Handle> handles;
+    handles.reserve(n);
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        handles.push_back(heap.insert(1000000000ull + rng() % 1000000000ull, i));
+    }
+    auto t1 = std::chrono::steady_clock::now();
 
-        // Ensure state is clean after deletion
-        minNode = nullptr;
-        nodeCount = 0;
+    // Interleave a few extractions so the trees are consolidated and
+    // decreaseKey has to cut real subtrees
+    for (int i = 0; i < n / 100; ++i) {
+        heap.extractMin();
     }
-};
+    auto t2 = std::chrono::steady_clock::now();
+    for (int i = 0; i < decreases; ++i) {
+        auto h = handles[rng() % n];
+        if (!heap.contains(h)) continue;
+        uint64_t current = heap.key(h);
+        heap.decreaseKey(h, current - current / 4);
+    }
+    auto t3 = std::chrono::steady_clock::now();
+
+    uint64_t previous = 0;
+    bool sorted = true;
+    int remaining = heap.size();
+    while (!heap.empty()) {
+        uint64_t k = heap.extractMin();
+        sorted = sorted && k >= previous;
+        previous = k;
+    }
+    auto t4 = std::chrono::steady_clock::now();
+
+    auto ns = [](std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b, double ops) {
+        return std::chrono::duration<double, std::nano>(b - a).count() / ops;
+    };
+    std::cout << "n = " << n << ", " << decreases << " decreaseKey calls" << std::endl;
+    std::cout << "  insert:      " << ns(t0, t1, n) << " ns/op" << std::endl;
+    std::cout << "  decreaseKey: " << ns(t2, t3, decreases) << " ns/op" << std::endl;
+    std::cout << "  extractMin:  " << ns(t3, t4, remaining) << " ns/op"
+              << (sorted ? "" : "  NOT SORTED") << std::endl;
+    std::cout << "  pool nodes:  " << heap.poolCapacity() << std::endl;
+}
 
 // Example usage of the Fibonacci Heap
-int main() {
-    FibonacciHeap fh;
+int main(int argc, char* argv[]) {
+    FibonacciHeap<int, char> fh;
+    std::vector<FibonacciHeap<int, char>::Handle> handles;
 
     // Insert some nodes and print after each insertion
     std::cout << "--- Inserting Nodes ---" << std::endl;
     int values[] = {5, 10, 2, 8, 1, 15, 3, 7};
     for (int val : values) {
-        fh.insert(val);
+        handles.push_back(fh.insert(val, static_cast<char>('A' + handles.size())));
         std::cout << "Inserted " << val << ", Current Heap:" << std::endl;
         fh.printHeap();
         std::cout << "Min: " << fh.getMin() << ", Size: " << fh.size() << std::endl << std::endl;
     }
+    FibonacciHeap<int, char>::Handle handleOf8 = handles[3];
+    FibonacciHeap<int, char>::Handle handleOf10 = handles[1];
+    FibonacciHeap<int, char>::Handle handleOf1 = handles[4];
 
 
     std::cout << "\n--- Extracting Minimum ---" << std::endl;
     try {
-        int minVal = fh.extractMin();
-        std::cout << "Extracted Min: " << minVal << std::endl;
+        std::pair<int, char> minEntry = fh.extractMinEntry();
+        std::cout << "Extracted Min: " << minEntry.first << " (value " << minEntry.second << ")" << std::endl;
         std::cout << "Heap after extracting min:" << std::endl;
         fh.printHeap();
         std::cout << "Min: " << fh.getMin() << ", Size: " << fh.size() << std::endl << std::endl;
@@ -508,17 +528,18 @@ int main() {
 
     std::cout << "\n--- Decreasing Key ---" << std::endl;
     try {
-        fh.decreaseKey(8, 0); // Decrease 8 to 0
+        fh.decreaseKey(handleOf8, 0); // Decrease 8 to 0
         std::cout << "Heap after decreasing key of 8 to 0:" << std::endl;
         fh.printHeap();
-        std::cout << "Min: " << fh.getMin() << ", Size: " << fh.size() << std::endl << std::endl;
+        std::cout << "Min: " << fh.getMin() << " (value " << fh.getMinValue() << "), Size: " << fh.size()
+                  << std::endl << std::endl;
     } catch (const std::exception& e) {
          std::cerr << "Error decreasing key: " << e.what() << std::endl;
     }
 
      std::cout << "\n--- Deleting Node ---" << std::endl;
     try {
-        fh.deleteNode(10); // Delete node with key 10
+        fh.deleteNode(handleOf10); // Delete node with key 10
         std::cout << "Heap after deleting node with key 10:" << std::endl;
         fh.printHeap();
          std::cout << "Min: " << fh.getMin() << ", Size: " << fh.size() << std::endl << std::endl;
@@ -526,6 +547,13 @@ int main() {
          std::cerr << "Error deleting node: " << e.what() << std::endl;
     }
 
+    std::cout << "\n--- Stale Handle ---" << std::endl;
+    try {
+        fh.decreaseKey(handleOf1, -1); // 1 was already extracted
+    } catch (const std::out_of_range& e) {
+         std::cout << "Rejected: " << e.what() << std::endl;
+    }
+
 
     // Check the size and if it is empty
     std::cout << "\n--- Final Checks ---" << std::endl;
@@ -548,6 +576,22 @@ int main() {
     fh.printHeap();
     std::cout << "Size: " << fh.size() << std::endl;
 
+    // A max-heap is just a different comparator
+    FibonacciHeap<int, int, std::greater<int>> maxHeap;
+    for (int val : values) {
+        maxHeap.insert(val);
+    }
+    std::cout << "\nMax-heap order: ";
+    while (!maxHeap.empty()) {
+        std::cout << maxHeap.extractMin() << " ";
+    }
+    std::cout << std::endl;
+
+    // Usage: 02-FibonacciHeap --benchmark
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        std::cout << "\n--- Benchmark ---" << std::endl;
+        benchmarkDecreaseKey(1000000, 3000000);
+    }
 
     return 0;
 }
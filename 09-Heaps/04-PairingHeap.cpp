@@ -6,48 +6,50 @@
 
 // Forward declaration is not strictly needed here anymore as Node is defined before its use
 // within the class, but it doesn't hurt.
+template <typename T>
 struct Node;
 
 // Define the Node struct for the Pairing Heap.
-// Removed the 'prev' pointer for a standard implementation.
+// 'prev' lets decreaseKey cut a node out of its sibling list in O(1).
+template <typename T>
 struct Node {
-    int data;
+    T data;
     Node* child; // Pointer to the leftmost child
     Node* next;  // Pointer to the next sibling (to the right)
+    Node* prev;  // Parent if this is the leftmost child, else the sibling to the left
 
-    Node(int value) : data(value), child(nullptr), next(nullptr) {}
+    Node(const T& value) : data(value), child(nullptr), next(nullptr), prev(nullptr) {}
 };
 
-// Class for the Pairing Heap.
+// Class for the Pairing Heap (int keys by default).
+template <typename T = int>
 class PairingHeap {
 private:
-    Node* root;
-
-    // Helper function to recursively destroy the heap nodes.
-    void destroyRecursive(Node* node) {
-        if (!node) {
-            return;
+    Node<T>* root;
+
+    // Helper function to destroy the heap nodes.
+    // Iterative with an explicit stack: a pairing heap can be a long chain
+    // of children, and each node is freed only after its links are read.
+    void destroyAll(Node<T>* node) {
+        std::vector<Node<T>*> pending;
+        if (node) pending.push_back(node);
+        while (!pending.empty()) {
+            Node<T>* current = pending.back();
+            pending.pop_back();
+            if (current->child) pending.push_back(current->child);
+            if (current->next) pending.push_back(current->next);
+            delete current;
         }
-        // Recursively destroy siblings first, then children
-        // This avoids deep recursion on the child pointers in skewed trees
-        Node* currentSibling = node->next;
-        while(currentSibling) {
-            Node* nextSibling = currentSibling->next;
-            destroyRecursive(currentSibling);
-            currentSibling = nextSibling;
-        }
-        // Now destroy the children
-        destroyRecursive(node->child);
-        // Finally, delete the node itself
-        delete node;
     }
 
 
     // Core merge operation: Merges h2 into h1, assuming h1->data <= h2->data.
     // Makes h2 the leftmost child of h1.
-    Node* link(Node* h1, Node* h2) {
+    Node<T>* link(Node<T>* h1, Node<T>* h2) {
         // h2 becomes the new leftmost child of h1
         h2->next = h1->child; // h2's right sibling is h1's old first child
+        if (h1->child) h1->child->prev = h2;
+        h2->prev = h1;        // the leftmost child points back at its parent
         h1->child = h2;       // h1's first child is now h2
         // Note: No need to manage h2's original children or siblings here,
         // they remain attached to h2.
@@ -56,7 +58,7 @@ private:
 
     // Merges two heaps/subtrees, returning the resulting root.
     // Handles null cases and ensures the smaller root becomes the parent.
-    Node* merge(Node* h1, Node* h2) {
+    Node<T>* merge(Node<T>* h1, Node<T>* h2) {
         if (!h1) return h2;
         if (!h2) return h1;
 
@@ -69,24 +71,26 @@ private:
     }
 
     // Helper function to perform the two-pass merge required by deleteMin.
-    Node* mergeSiblings(Node* firstSibling) {
+    Node<T>* mergeSiblings(Node<T>* firstSibling) {
         if (!firstSibling || !firstSibling->next) {
+            if (firstSibling) firstSibling->prev = nullptr; // It becomes a root
             return firstSibling; // Zero or one sibling requires no merging
         }
 
         // Two-pass merge:
-        std::vector<Node*> siblings;
-        Node* current = firstSibling;
+        std::vector<Node<T>*> siblings;
+        Node<T>* current = firstSibling;
         // Isolate siblings before merging
         while (current) {
-            Node* next = current->next;
-            current->next = nullptr; // Disconnect sibling pointer for merging
+            Node<T>* next = current->next;
+            current->next = nullptr; // Disconnect sibling pointers for merging
+            current->prev = nullptr;
             siblings.push_back(current);
             current = next;
         }
 
         // Pass 1: Merge pairs from left to right
-        std::vector<Node*> mergedPairs;
+        std::vector<Node<T>*> mergedPairs;
         mergedPairs.reserve(siblings.size() / 2 + 1); // Optimization: reserve space
         for (size_t i = 0; i + 1 < siblings.size(); i += 2) {
             mergedPairs.push_back(merge(siblings[i], siblings[i + 1]));
@@ -106,7 +110,7 @@ private:
 
 
         // Pass 2: Merge the resulting pairs from right to left
-        Node* finalRoot = mergedPairs.back();
+        Node<T>* finalRoot = mergedPairs.back();
         for (int i = mergedPairs.size() - 2; i >= 0; --i) {
             finalRoot = merge(mergedPairs[i], finalRoot);
         }
@@ -117,13 +121,13 @@ private:
 
     // Helper function to print the tree recursively.
     // *** Added const qualifier here ***
-    void printTree(Node* node, int depth) const {
+    void printTree(Node<T>* node, int depth) const {
         if (node) {
             // Print current node
             std::cout << std::setw(depth * 4) << "" << node->data << std::endl;
 
             // Recursively print children (and their siblings)
-            Node* child = node->child;
+            Node<T>* child = node->child;
             while (child) {
                 printTree(child, depth + 1);
                 child = child->next; // Move to the next sibling
@@ -133,12 +137,15 @@ private:
 
 
 public:
+    // Returned by insert; stays valid until that element is removed by deleteMin.
+    using Handle = Node<T>*;
+
     // Constructor.
     PairingHeap() : root(nullptr) {}
 
     // Destructor to free memory.
     ~PairingHeap() {
-        destroyRecursive(root);
+        destroyAll(root);
         root = nullptr; // Good practice after deletion
     }
 
@@ -156,13 +163,42 @@ public:
     }
 
     // Function to insert a new element into the Pairing Heap.
-    void insert(int value) {
-        Node* newNode = new Node(value);
+    // Returns a handle for decreaseKey.
+    Handle insert(const T& value) {
+        Node<T>* newNode = new Node<T>(value);
         root = merge(root, newNode);
+        return newNode;
+    }
+
+    // Lowers the value behind a handle: the node's subtree is cut from its
+    // parent and merged with the root, O(1) (amortized o(log n)).
+    void decreaseKey(Handle node, const T& newValue) {
+        if (!node) {
+            throw std::invalid_argument("Null handle");
+        }
+        if (node->data < newValue) {
+            throw std::invalid_argument("New value is greater than the current value");
+        }
+        node->data = newValue;
+        if (node == root) {
+            return;
+        }
+        // Unlink the subtree rooted at node from its sibling list
+        if (node->prev->child == node) {
+            node->prev->child = node->next;
+        } else {
+            node->prev->next = node->next;
+        }
+        if (node->next) {
+            node->next->prev = node->prev;
+        }
+        node->next = nullptr;
+        node->prev = nullptr;
+        root = merge(root, node);
     }
 
     // Function to find the minimum element in the Pairing Heap.
-    int findMin() const { // Added const qualifier
+    const T& findMin() const { // Added const qualifier
         if (isEmpty()) {
             throw std::runtime_error("Heap is empty");
         }
@@ -170,14 +206,14 @@ public:
     }
 
     // Function to delete the minimum element from the Pairing Heap.
-    int deleteMin() {
+    T deleteMin() {
         if (isEmpty()) {
             throw std::runtime_error("Heap is empty");
         }
 
-        int minVal = root->data;
-        Node* oldRoot = root;
-        Node* firstChild = root->child;
+        T minVal = root->data;
+        Node<T>* oldRoot = root;
+        Node<T>* firstChild = root->child;
 
         // Important: Nullify root's child pointer *before* deleting oldRoot
         // to prevent mergeSiblings from accessing deleted memory via firstChild
@@ -221,7 +257,7 @@ int main() {
     ph.insert(1);
     std::cout <<" Inserted 1:\n";
     ph.printHeap();
-    ph.insert(9);
+    PairingHeap<>::Handle nine = ph.insert(9);
     std::cout <<" Inserted 9:\n";
     ph.printHeap();
     ph.insert(3);
@@ -244,6 +280,11 @@ int main() {
     try {
         std::cout << "Minimum element: " << ph.findMin() << std::endl;
 
+        // Decrease-key through the handle returned by insert(9).
+        ph.decreaseKey(nine, 0);
+        std::cout << "\nAfter decreasing 9 to 0:\n";
+        ph.printHeap();
+
         // Delete the minimum element.
         std::cout << "\nDeleting minimum: " << ph.deleteMin() << std::endl;
         std::cout << "Pairing Heap after deleting minimum:\n";
@@ -267,7 +308,7 @@ int main() {
         // Try finding min on empty heap
         // std::cout << ph.findMin() << std::endl; // Uncomment to test exception
 
-    } catch (const std::runtime_error& e) {
+    } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
     }
 
@@ -30,10 +30,12 @@
  /**
   * @class TreapNode
   * @brief Node structure for the Treap
+  * @tparam T Key type (must support <, > and ==)
   */
+ template <typename T>
  class TreapNode {
  public:
-     int key;            // Value stored in the node (fulfills BST property)
+     T key;              // Value stored in the node (fulfills BST property)
      int priority;       // Random priority (fulfills heap property)
      TreapNode* left;    // Pointer to left child
      TreapNode* right;   // Pointer to right child
@@ -43,7 +45,7 @@
       * @param key The key value to be stored
       * @param priority The priority value (random if not specified)
       */
-     TreapNode(int key, int priority = -1) {
+     TreapNode(const T& key, int priority = -1) {
          this->key = key;
          // If priority not specified, generate a random one
          this->priority = (priority == -1) ? dist(gen) : priority;
@@ -55,10 +57,12 @@
  /**
   * @class Treap
   * @brief Implementation of Treap data structure
+  * @tparam T Key type (must support <, > and ==); int by default
   */
+ template <typename T = int>
  class Treap {
  private:
-     TreapNode* root;  // Root of the Treap
+     TreapNode<T>* root;  // Root of the Treap
  
      /**
       * @brief Perform a right rotation at the given node
@@ -71,10 +75,10 @@
       *  / \            / \
       * A   B          B   C
       */
-     TreapNode* rightRotate(TreapNode* y) {
+     TreapNode<T>* rightRotate(TreapNode<T>* y) {
          if (!y || !y->left) return y; // Cannot rotate if y or left child is null
-         TreapNode* x = y->left;
-         TreapNode* B = x->right;
+         TreapNode<T>* x = y->left;
+         TreapNode<T>* B = x->right;
  
          // Perform rotation
          x->right = y;
@@ -95,10 +99,10 @@
       *    / \        / \
       *   B   C      A   B
       */
-     TreapNode* leftRotate(TreapNode* x) {
+     TreapNode<T>* leftRotate(TreapNode<T>* x) {
          if (!x || !x->right) return x; // Cannot rotate if x or right child is null
-         TreapNode* y = x->right;
-         TreapNode* B = y->left;
+         TreapNode<T>* y = x->right;
+         TreapNode<T>* B = y->left;
  
          // Perform rotation
          y->left = x;
@@ -115,12 +119,12 @@
       * @param priority Priority for the new key
       * @return Root of the subtree after insertion
       */
-     TreapNode* insert(TreapNode* currentRoot, int key, int priority = -1) {
+     TreapNode<T>* insert(TreapNode<T>* currentRoot, const T& key, int priority = -1) {
          // Base case: If tree is empty, return a new node
          if (currentRoot == nullptr) {
              // Generate priority here if needed, ensuring it's always set
              int nodePriority = (priority == -1) ? dist(gen) : priority;
-             return new TreapNode(key, nodePriority);
+             return new TreapNode<T>(key, nodePriority);
          }
  
          // BST insert: If key is smaller, insert into left subtree
@@ -154,7 +158,7 @@
       * @param key Key to search for
       * @return Node containing the key, or nullptr if not found
       */
-     TreapNode* search(TreapNode* currentRoot, int key) {
+     TreapNode<T>* search(TreapNode<T>* currentRoot, const T& key) {
          // Base case: root is null or key found
          if (currentRoot == nullptr || currentRoot->key == key) {
              return currentRoot;
@@ -175,7 +179,7 @@
       * @param key Key to delete
       * @return Root of the subtree after deletion
       */
-     TreapNode* remove(TreapNode* currentRoot, int key) {
+     TreapNode<T>* remove(TreapNode<T>* currentRoot, const T& key) {
          // Base case: If tree is empty
          if (currentRoot == nullptr) {
              return currentRoot;
@@ -194,12 +198,12 @@
          else {
              // Case 1 & 2: Node with only one child or no child
              if (currentRoot->left == nullptr) {
-                 TreapNode* temp = currentRoot->right;
+                 TreapNode<T>* temp = currentRoot->right;
                  delete currentRoot;
                  currentRoot = temp; // Becomes nullptr if right was also null
              }
              else if (currentRoot->right == nullptr) {
-                 TreapNode* temp = currentRoot->left;
+                 TreapNode<T>* temp = currentRoot->left;
                  delete currentRoot;
                  currentRoot = temp;
              }
@@ -228,7 +232,7 @@
       * @param left Reference to root of left subtree
       * @param right Reference to root of right subtree
       */
-     void split(TreapNode* currentRoot, int key, TreapNode*& left, TreapNode*& right) {
+     void split(TreapNode<T>* currentRoot, const T& key, TreapNode<T>*& left, TreapNode<T>*& right) {
          if (currentRoot == nullptr) {
              left = nullptr;
              right = nullptr;
@@ -261,7 +265,7 @@
       * @param right Root of right Treap (all keys assumed > all keys in left)
       * @return Root of the merged Treap
       */
-     TreapNode* merge(TreapNode* left, TreapNode* right) {
+     TreapNode<T>* merge(TreapNode<T>* left, TreapNode<T>* right) {
          // Base cases
          if (left == nullptr) return right;
          if (right == nullptr) return left;
@@ -286,13 +290,13 @@
       * @return The minimum key
       * @throws std::runtime_error if the Treap is empty
       */
-     int findMin(TreapNode* currentRoot) {
+     T findMin(TreapNode<T>* currentRoot) {
          // The leftmost node contains the minimum key
          if (currentRoot == nullptr) {
              throw std::runtime_error("Cannot find minimum in empty Treap");
          }
  
-         TreapNode* current = currentRoot;
+         TreapNode<T>* current = currentRoot;
          while (current->left != nullptr) {
              current = current->left;
          }
@@ -305,13 +309,13 @@
       * @return The maximum key
       * @throws std::runtime_error if the Treap is empty
       */
-     int findMax(TreapNode* currentRoot) {
+     T findMax(TreapNode<T>* currentRoot) {
          // The rightmost node contains the maximum key
          if (currentRoot == nullptr) {
              throw std::runtime_error("Cannot find maximum in empty Treap");
          }
  
-         TreapNode* current = currentRoot;
+         TreapNode<T>* current = currentRoot;
          while (current->right != nullptr) {
              current = current->right;
          }
@@ -322,7 +326,7 @@
       * @brief Helper function to clear the Treap (free all memory)
       * @param currentRoot Root of the subtree to clear
       */
-     void clear(TreapNode* currentRoot) {
+     void clear(TreapNode<T>* currentRoot) {
          if (currentRoot == nullptr) {
              return;
          }
@@ -337,7 +341,7 @@
       * @brief Helper function to print tree in-order
       * @param currentRoot Root of current subtree
       */
-     void inOrderTraversal(TreapNode* currentRoot) {
+     void inOrderTraversal(TreapNode<T>* currentRoot) {
          if (currentRoot != nullptr) {
              inOrderTraversal(currentRoot->left);
              std::cout << currentRoot->key << "(p:" << currentRoot->priority << ") ";
@@ -350,7 +354,7 @@
       * @param node Node to find height of
       * @return Height of the node (number of edges on longest path)
       */
-     int getHeightRecursive(TreapNode* node) {
+     int getHeightRecursive(TreapNode<T>* node) {
          if (node == nullptr) {
              return -1; // Height of empty subtree is -1
          }
@@ -364,7 +368,7 @@
       * @param prefix The prefix string for drawing lines
       * @param isLeft True if the current node is a left child, false otherwise
       */
-     void printTreapRecursive(TreapNode* node, const std::string& prefix, bool isLeft) {
+     void printTreapRecursive(TreapNode<T>* node, const std::string& prefix, bool isLeft) {
          if (node == nullptr) {
              return;
          }
@@ -421,7 +425,7 @@
       * @param key Key to insert
       * @param priority Priority for the new key (optional, random by default)
       */
-     void insert(int key, int priority = -1) {
+     void insert(const T& key, int priority = -1) {
          // Pass the explicit priority if provided, otherwise let the helper handle -1
          root = insert(root, key, priority);
      }
@@ -430,7 +434,7 @@
       * @brief Remove a key from the Treap
       * @param key Key to remove
       */
-     void remove(int key) {
+     void remove(const T& key) {
          root = remove(root, key);
      }
  
@@ -439,7 +443,7 @@
       * @param key Key to search for
       * @return true if found, false otherwise
       */
-     bool search(int key) {
+     bool search(const T& key) {
          return search(root, key) != nullptr;
      }
  
@@ -448,7 +452,7 @@
       * @return The minimum key
       * @throws std::runtime_error if the Treap is empty
       */
-     int getMin() {
+     T getMin() {
          // No need to check for empty here, findMin helper does it
          return findMin(root);
      }
@@ -458,7 +462,7 @@
       * @return The maximum key
       * @throws std::runtime_error if the Treap is empty
       */
-     int getMax() {
+     T getMax() {
          // No need to check for empty here, findMax helper does it
          return findMax(root);
      }
@@ -514,15 +518,15 @@
       * @param rightTreap Reference to the Treap that will hold keys > key.
       * @note The original Treap becomes empty after the split.
       */
-     void splitTreap(int key, Treap& leftTreap, Treap& rightTreap) {
+     void splitTreap(const T& key, Treap& leftTreap, Treap& rightTreap) {
          // Ensure the target treaps are empty before splitting into them
          leftTreap.clear(leftTreap.root);
          leftTreap.root = nullptr;
          rightTreap.clear(rightTreap.root);
          rightTreap.root = nullptr;
  
-         TreapNode* leftRoot = nullptr;
-         TreapNode* rightRoot = nullptr;
+         TreapNode<T>* leftRoot = nullptr;
+         TreapNode<T>* rightRoot = nullptr;
  
          // Split the current treap's root
          split(root, key, leftRoot, rightRoot);
@@ -6,102 +6,214 @@
 #include <iomanip>
 #include <sstream>
 #include <queue>
+#include <new>         // For std::align_val_t
+#include <type_traits>
+#include <functional>  // For std::greater (benchmark baseline)
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Allocator that aligns the heap's storage to a cache-line boundary
+template <typename T, std::size_t Align>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+    }
 
-// A class template for a D-ary Min Heap
-template <typename T>
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(Align));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Align>&) const { return false; }
+};
+
+// Picks the smallest of D consecutive siblings (the first one on ties).
+// The tournament is expanded at compile time, so it is fully unrolled, and
+// its two halves are independent, which gives a dependency chain of log2(D)
+// compares instead of D - 1.
+template <typename T, int D, typename Enable = void>
+struct MinChildSelector {
+    template <int Lo, int Len>
+    static int tournament(const T* group) {
+        if constexpr (Len == 1) {
+            return Lo;
+        } else {
+            int left = tournament<Lo, Len / 2>(group);
+            int right = tournament<Lo + Len / 2, Len - Len / 2>(group);
+            return group[right] < group[left] ? right : left;
+        }
+    }
+
+    static int select(const T* group) {
+        return tournament<0, D>(group);
+    }
+};
+
+#if defined(__SSE2__)
+// SIMD version for 32-bit int keys when a sibling group is a whole number of
+// 16-byte vectors: a vertical min across the group, a horizontal min inside
+// one vector, then the first lane equal to the minimum. SSE2 has no 32-bit
+// signed min instruction, so min is compare + blend.
+template <int D>
+struct MinChildSelector<int, D, typename std::enable_if<sizeof(int) == 4 && D % 4 == 0>::type> {
+    static __m128i min32(__m128i a, __m128i b) {
+        __m128i aLess = _mm_cmplt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(aLess, a), _mm_andnot_si128(aLess, b));
+    }
+
+    // group is 16-byte aligned: groups start at multiples of D in 64-byte aligned storage
+    static int select(const int* group) {
+        const __m128i* lanes = reinterpret_cast<const __m128i*>(group);
+        __m128i m = _mm_load_si128(lanes);
+        for (int j = 1; j < D / 4; ++j) {
+            m = min32(m, _mm_load_si128(lanes + j));
+        }
+        m = min32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+        m = min32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+        unsigned mask = 0;
+        for (int j = 0; j < D / 4; ++j) {
+            __m128i equal = _mm_cmpeq_epi32(_mm_load_si128(lanes + j), m);
+            mask |= static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(equal))) << (4 * j);
+        }
+        return __builtin_ctz(mask);
+    }
+};
+#endif
+
+// A class template for a D-ary Min Heap with the degree fixed at compile time.
+//
+// Layout: the array starts with D - 1 unused slots, so the root sits at slot
+// D - 1 and the children of every node start at a multiple of D. With the
+// storage aligned to 64 bytes, each sibling group then starts on its own
+// boundary; when D * sizeof(T) == 64 (e.g. D = 16 for int, D = 8 for 8-byte
+// keys) a heapifyDown step reads exactly one cache line per level.
+// Public indices (decreaseKey, getElementAtIndex) are the usual 0-based
+// level-order positions; the padding is internal.
+template <typename T, int D>
 class DaryHeap {
 private:
-    std::vector<T> heap; // The array to store heap elements
-    int degree;          // The degree D of the heap
-    int capacity;        // Maximum capacity of the heap
-
-    // Helper function to get the parent index of a node
-    int parent(int i) const {
-        if (i == 0) return -1; // Root has no parent
-        return (i - 1) / degree;
+    static_assert(D >= 2, "Degree D must be greater than 1.");
+    static const std::size_t CACHE_LINE = 64;
+    static const std::size_t ROOT = D - 1; // Slot of the root
+
+    std::vector<T, AlignedAllocator<T, CACHE_LINE>> heap; // Slots [0, ROOT) are padding
+
+    // Helper function to get the parent slot of a non-root slot
+    static std::size_t parent(std::size_t slot) {
+        return slot / D + D - 2;
+    }
+
+    // Helper function to get the slot of the first child (the rest follow it)
+    static std::size_t firstChild(std::size_t slot) {
+        return D * (slot - D + 2);
     }
 
-    // Helper function to get the index of the k-th child of a node
-    int child(int i, int k) const {
-        return degree * i + k;
+    // Converts a public level-order index to a slot
+    static std::size_t slotOf(int i) {
+        return static_cast<std::size_t>(i) + ROOT;
     }
 
-    // Helper function to maintain the heap property by moving an element down
-    void heapifyDown(int i) {
-        int min_child_index;
+    // Helper function to maintain the heap property by moving an element down.
+    // The element is held aside and children are moved up into the hole, so
+    // each level costs one write instead of a swap.
+    void heapifyDown(std::size_t slot) {
+        const std::size_t end = heap.size();
+        T value = heap[slot];
         while (true) {
-            min_child_index = -1;
-            T min_child_value = std::numeric_limits<T>::max(); // Initialize with max possible value
-
-            // Find the smallest child among the D children
-            for (int k = 1; k <= degree; ++k) {
-                int current_child_index = child(i, k);
-                if (current_child_index < heap.size()) { // Check if child exists
-                    if (min_child_index == -1 || heap[current_child_index] < min_child_value) {
-                        min_child_value = heap[current_child_index];
-                        min_child_index = current_child_index;
-                    }
-                } else {
-                    // No more children in this range
-                    break;
+            std::size_t first = firstChild(slot);
+            if (first >= end) {
+                break; // No children
+            }
+
+            std::size_t minChild;
+            if (first + D <= end) {
+                // Full sibling group: unrolled / SIMD selection
+                minChild = first + MinChildSelector<T, D>::select(&heap[first]);
+            } else {
+                // Only the last group of the heap can be partial
+                minChild = first;
+                for (std::size_t c = first + 1; c < end; ++c) {
+                    if (heap[c] < heap[minChild]) minChild = c;
                 }
             }
 
-            // If no children or the current node is smaller than its smallest child, stop
-            if (min_child_index == -1 || heap[i] <= heap[min_child_index]) {
+            // If the element is not larger than its smallest child, stop
+            if (!(heap[minChild] < value)) {
                 break;
             }
-
-            // Swap the current node with the smallest child
-            std::swap(heap[i], heap[min_child_index]);
-
-            // Move down to the child's position and continue heapifying
-            i = min_child_index;
+            heap[slot] = heap[minChild];
+            slot = minChild;
         }
+        heap[slot] = value;
     }
 
     // Helper function to maintain the heap property by moving an element up
-    void heapifyUp(int i) {
-        while (i > 0 && heap[i] < heap[parent(i)]) {
-            std::swap(heap[i], heap[parent(i)]);
-            i = parent(i);
+    void heapifyUp(std::size_t slot) {
+        T value = heap[slot];
+        while (slot > ROOT) {
+            std::size_t p = parent(slot);
+            if (!(value < heap[p])) {
+                break;
+            }
+            heap[slot] = heap[p];
+            slot = p;
         }
+        heap[slot] = value;
     }
 
 public:
-    // Constructor
-    DaryHeap(int d, int cap) : degree(d), capacity(cap) {
-        if (d <= 1) {
-            throw std::invalid_argument("Degree D must be greater than 1.");
-        }
-        if (cap <= 0) {
+    // Constructor. The capacity is only an initial reservation; the heap grows as needed.
+    explicit DaryHeap(int initialCapacity = 16) {
+        if (initialCapacity <= 0) {
             throw std::invalid_argument("Capacity must be positive.");
         }
-        heap.reserve(capacity); // Reserve memory
+        heap.reserve(ROOT + initialCapacity); // Reserve memory
+        heap.resize(ROOT);                    // Padding slots before the root
+    }
+
+    // The degree D of the heap
+    static constexpr int degree() {
+        return D;
     }
 
     // Get the current size of the heap
     int size() const {
-        return heap.size();
+        return static_cast<int>(heap.size() - ROOT);
     }
 
     // Check if the heap is empty
     bool isEmpty() const {
-        return heap.empty();
+        return heap.size() == ROOT;
     }
 
-    // Check if the heap is full
-    bool isFull() const {
-        return heap.size() == capacity;
+    // Number of elements the heap can hold before it reallocates
+    int capacity() const {
+        return static_cast<int>(heap.capacity() - ROOT);
     }
 
     // Insert an element into the heap
     void insert(const T& value) {
-        if (isFull()) {
-            std::cerr << "Error: Heap is full. Cannot insert." << std::endl;
-            return;
-        }
-        heap.push_back(value); // Add to the end
+        heap.push_back(value);      // Add to the end (grows the storage if needed)
         heapifyUp(heap.size() - 1); // Heapify up the new element
     }
 
@@ -110,27 +222,28 @@ public:
         if (isEmpty()) {
             throw std::out_of_range("Heap is empty. Cannot extract minimum.");
         }
-        T min_value = heap[0]; // The minimum is at the root
-        heap[0] = heap.back(); // Move the last element to the root
-        heap.pop_back();       // Remove the last element
+        T min_value = heap[ROOT]; // The minimum is at the root
+        heap[ROOT] = heap.back(); // Move the last element to the root
+        heap.pop_back();          // Remove the last element
         if (!isEmpty()) {
-            heapifyDown(0);    // Heapify down the new root
+            heapifyDown(ROOT);    // Heapify down the new root
         }
         return min_value;
     }
 
     // Decrease the key of an element at a given index (for a min-heap)
     void decreaseKey(int i, const T& newValue) {
-        if (i < 0 || i >= heap.size()) {
+        if (i < 0 || i >= size()) {
             throw std::out_of_range("Invalid index.");
         }
-        if (newValue > heap[i]) {
-            std::cerr << "Warning: New value (" << newValue << ") is greater than current value (" << heap[i] << ") at index " << i << ". Performing heapifyDown instead of heapifyUp." << std::endl;
-            heap[i] = newValue; // Update the value
-            heapifyDown(i);     // Heapify down to restore heap property
+        std::size_t slot = slotOf(i);
+        if (newValue > heap[slot]) {
+            std::cerr << "Warning: New value (" << newValue << ") is greater than current value (" << heap[slot] << ") at index " << i << ". Performing heapifyDown instead of heapifyUp." << std::endl;
+            heap[slot] = newValue; // Update the value
+            heapifyDown(slot);     // Heapify down to restore heap property
         } else {
-            heap[i] = newValue; // Update the value
-            heapifyUp(i);       // Heapify up to restore heap property
+            heap[slot] = newValue; // Update the value
+            heapifyUp(slot);       // Heapify up to restore heap property
         }
     }
 
@@ -139,22 +252,19 @@ public:
         if (isEmpty()) {
             throw std::out_of_range("Heap is empty. No minimum element.");
         }
-        return heap[0];
+        return heap[ROOT];
     }
 
     // Build a heap from a vector of elements
     void buildHeap(const std::vector<T>& elements) {
-        heap = elements; // Copy elements to the heap vector
-        if (heap.size() > capacity) {
-            std::cerr << "Warning: Input elements exceed heap capacity. Building with available elements." << std::endl;
-            heap.resize(capacity); // Truncate if exceeds capacity
-        }
+        heap.resize(ROOT);
+        heap.insert(heap.end(), elements.begin(), elements.end()); // Copy elements after the padding
 
         // Start from the last non-leaf node and heapify down
-        int start_index = (heap.size() > 1) ? (heap.size() - 2) / degree : -1;
+        int start_index = (size() > 1) ? (size() - 2) / D : -1;
 
         for (int i = start_index; i >= 0; --i) {
-            heapifyDown(i);
+            heapifyDown(slotOf(i));
         }
     }
 
@@ -165,14 +275,14 @@ public:
             return;
         }
 
-        std::cout << "D-ary Heap (D=" << degree << "):" << std::endl;
+        std::cout << "D-ary Heap (D=" << D << "):" << std::endl;
 
         // Calculate maximum width for values and indices
         size_t max_value_width = 0;
         size_t max_index_width = 0;
-        for (size_t i = 0; i < heap.size(); ++i) {
+        for (int i = 0; i < size(); ++i) {
             std::stringstream ss;
-            ss << heap[i];
+            ss << heap[slotOf(i)];
             max_value_width = std::max(max_value_width, ss.str().length());
             ss.str("");
             ss << i;
@@ -206,12 +316,12 @@ public:
             // Format the current node
             std::stringstream ss;
             ss << "Index " << std::setw(max_index_width) << std::left << index
-               << ": Value " << std::setw(max_value_width) << std::left << heap[index]
+               << ": Value " << std::setw(max_value_width) << std::left << heap[slotOf(index)]
                << ", Children: [";
             std::vector<int> children;
-            for (int k = 1; k <= degree; ++k) {
-                int child_index = child(index, k);
-                if (child_index < heap.size()) {
+            for (int k = 1; k <= D; ++k) {
+                int child_index = D * index + k;
+                if (child_index < size()) {
                     children.push_back(child_index);
                     q.push({child_index, level + 1});
                 }
@@ -238,56 +348,127 @@ public:
 
     // Public method to access an element by index (use with caution, doesn't guarantee heap property)
     const T& getElementAtIndex(int i) const {
-        if (i < 0 || i >= heap.size()) {
+        if (i < 0 || i >= size()) {
             throw std::out_of_range("Invalid index.");
         }
-        return heap[i];
+        return heap[slotOf(i)];
     }
 };
 
+// ---------- Benchmark: arity sweep on push/pop-heavy workloads ----------
+
+// Baseline with the same interface, backed by std::priority_queue
+template <typename T>
+struct StdPriorityQueue {
+    std::priority_queue<T, std::vector<T>, std::greater<T>> pq;
+    void insert(const T& value) { pq.push(value); }
+    T extractMin() { T top = pq.top(); pq.pop(); return top; }
+};
+
+// Two workloads on a heap of `n` random keys (the heap grows from its default capacity):
+//   hold: `holds` rounds of extractMin followed by inserting that key plus a
+//         random increment, the steady state of an event queue
+//   sort: insert n keys, then extract them all
+// Returns ns per operation for each, and accumulates a checksum.
+template <typename Heap, typename T>
+void runWorkloads(int n, int holds, double& holdNs, double& sortNs, uint64_t& checksum) {
+    std::mt19937_64 rng(25);
+    Heap heap;
+    for (int i = 0; i < n; ++i) {
+        heap.insert(static_cast<T>(rng() % 1000000000));
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < holds; ++i) {
+        T top = heap.extractMin();
+        checksum += static_cast<uint64_t>(top);
+        heap.insert(static_cast<T>(top + static_cast<T>(rng() % 1000000)));
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    holdNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / (2.0 * holds);
+
+    Heap sortHeap;
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        sortHeap.insert(static_cast<T>(rng() % 1000000000));
+    }
+    T previous = std::numeric_limits<T>::min();
+    for (int i = 0; i < n; ++i) {
+        T value = sortHeap.extractMin();
+        if (value < previous) checksum = 0; // Out of order: poison the checksum
+        previous = value;
+    }
+    t1 = std::chrono::steady_clock::now();
+    sortNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / (2.0 * n);
+}
+
+template <typename Heap, typename T>
+void reportWorkloads(const std::string& name, int n, int holds, uint64_t& expected) {
+    double holdNs, sortNs;
+    uint64_t checksum = 0;
+    runWorkloads<Heap, T>(n, holds, holdNs, sortNs, checksum);
+    if (expected == 0) expected = checksum;
+    std::cout << "  " << std::left << std::setw(26) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << holdNs << std::setw(10) << sortNs << (checksum == expected ? "" : "  MISMATCH")
+              << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+}
+
+template <typename T>
+void benchmarkArity(const std::string& keyName, int n, int holds) {
+    std::cout << "\n" << keyName << " keys, n = " << n << ", " << holds << " hold rounds (ns per insert/extract):" << std::endl;
+    std::cout << "  " << std::left << std::setw(26) << "heap" << std::right << std::setw(10) << "hold" << std::setw(10)
+              << "sort" << std::endl;
+    uint64_t expected = 0;
+    reportWorkloads<StdPriorityQueue<T>, T>("std::priority_queue", n, holds, expected);
+    reportWorkloads<DaryHeap<T, 2>, T>("DaryHeap<2>", n, holds, expected);
+    reportWorkloads<DaryHeap<T, 4>, T>("DaryHeap<4>", n, holds, expected);
+    reportWorkloads<DaryHeap<T, 8>, T>("DaryHeap<8>", n, holds, expected);
+    reportWorkloads<DaryHeap<T, 16>, T>("DaryHeap<16>", n, holds, expected);
+}
+
 // Example Usage
-int main() {
+int main(int argc, char* argv[]) {
     try {
-        // Create a 3-ary heap with capacity 20
-        DaryHeap<int> heap(3, 20);
+        // Create a 3-ary heap with initial capacity 20
+        DaryHeap<int, 3> heap(20);
 
         // Insert elements
         heap.insert(10);
         std::cout << "Inserted 10:\n";
         heap.printTree();
-        
+
         heap.insert(4);
         std::cout << "Inserted 4:\n";
         heap.printTree();
-        
+
         heap.insert(15);
         std::cout << "Inserted 15:\n";
         heap.printTree();
-        
+
         heap.insert(2);
         std::cout << "Inserted 2:\n";
         heap.printTree();
-        
+
         heap.insert(8);
         std::cout << "Inserted 8:\n";
         heap.printTree();
-        
+
         heap.insert(12);
         std::cout << "Inserted 12:\n";
         heap.printTree();
-        
+
         heap.insert(18);
         std::cout << "Inserted 18:\n";
         heap.printTree();
-        
+
         heap.insert(1);
         std::cout << "Inserted 1:\n";
         heap.printTree();
-        
+
         heap.insert(6);
         std::cout << "Inserted 6:\n";
         heap.printTree();
-        
+
         heap.insert(11);
         std::cout << "Inserted 11:\n";
         heap.printTree();
@@ -313,14 +494,22 @@ int main() {
 
         // Build heap from a vector
         std::vector<int> data = {5, 3, 17, 10, 8, 19, 1, 4, 9, 7};
-        DaryHeap<int> built_heap(4, 15); // Create a 4-ary heap
+        DaryHeap<int, 4> built_heap(4); // Create a 4-ary heap; it grows past its initial capacity
         built_heap.buildHeap(data);
         std::cout << "Heap built from vector (4-ary heap):" << std::endl;
         built_heap.printTree();
 
+        // Usage: 06-D-aryHeap --benchmark
+        // int keys use the SIMD child selection for D = 4, 8, 16; 64-bit keys the unrolled scalar one
+        if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+            std::cout << "--- Benchmark ---" << std::endl;
+            benchmarkArity<int>("int", 1000000, 4000000);
+            benchmarkArity<long long>("long long", 1000000, 4000000);
+        }
+
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
     }
 
     return 0;
-}
\ No newline at end of file
+}
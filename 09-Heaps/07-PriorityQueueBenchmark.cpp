@@ -0,0 +1,664 @@
+// Priority-queue benchmark: runs Dijkstra and Prim over generated graphs with
+// every heap in this folder behind one common decrease-key interface, and
+// reports time, peak memory and cache misses per queue operation.
+//
+// The heap sources are included directly, each inside its own namespace with
+// its demo main() renamed, so the numbers always reflect the code in this
+// folder. Every standard header those files use is included up front; inside
+// the namespaces their own #includes are then no-ops.
+//
+// Build: g++ -std=c++17 -O2 07-PriorityQueueBenchmark.cpp -o pq_benchmark
+// Usage: pq_benchmark [edges]
+//   edges defaults to 10^6 per graph. 10^7 - 10^8 works but needs several GB
+//   of memory and a long run, mostly in the slower node-based heaps.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <set>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <limits>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <random>
+#include <chrono>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace minheap {
+#define main demoMain
+#include "00-MinHeap.cpp"
+#undef main
+}
+
+namespace fibonacci {
+#define main demoMain
+#include "02-FibonacciHeap.cpp"
+#undef main
+}
+
+namespace binomial {
+#define main demoMain
+#include "03-BinomialHeap.cpp"
+#undef main
+}
+
+namespace pairing {
+#define main demoMain
+#include "04-PairingHeap.cpp"
+#undef main
+}
+
+namespace treap {
+#define main demoMain
+#include "05-Trap.cpp"
+#undef main
+}
+
+namespace dary {
+#define main demoMain
+#include "06-D-aryHeap.cpp"
+#undef main
+}
+
+// ---------- Allocation tracking ----------
+
+// Global operator new/delete keep a running total of live heap bytes, so each
+// run can report the peak it reached above the bytes live when it started.
+namespace allocation {
+std::size_t current = 0;
+std::size_t peak = 0;
+const std::size_t HEADER = 16; // Keeps max_align_t alignment and stores the size
+
+void* allocate(std::size_t size, std::size_t align) {
+    std::size_t header = std::max(HEADER, align);
+    void* base = align > HEADER ? std::aligned_alloc(align, (size + header + align - 1) / align * align)
+                                : std::malloc(size + header);
+    if (base == nullptr) {
+        throw std::bad_alloc();
+    }
+    char* p = static_cast<char*>(base) + header;
+    std::memcpy(p - sizeof(std::size_t), &size, sizeof(std::size_t));
+    current += size;
+    peak = std::max(peak, current);
+    return p;
+}
+
+void release(void* p, std::size_t align) {
+    if (p == nullptr) return;
+    std::size_t size;
+    std::memcpy(&size, static_cast<char*>(p) - sizeof(std::size_t), sizeof(std::size_t));
+    current -= size;
+    std::free(static_cast<char*>(p) - std::max(HEADER, align));
+}
+}
+
+void* operator new(std::size_t size) { return allocation::allocate(size, 0); }
+void* operator new[](std::size_t size) { return allocation::allocate(size, 0); }
+void* operator new(std::size_t size, std::align_val_t align) { return allocation::allocate(size, std::size_t(align)); }
+void* operator new[](std::size_t size, std::align_val_t align) { return allocation::allocate(size, std::size_t(align)); }
+void operator delete(void* p) noexcept { allocation::release(p, 0); }
+void operator delete[](void* p) noexcept { allocation::release(p, 0); }
+void operator delete(void* p, std::size_t) noexcept { allocation::release(p, 0); }
+void operator delete[](void* p, std::size_t) noexcept { allocation::release(p, 0); }
+void operator delete(void* p, std::align_val_t align) noexcept { allocation::release(p, std::size_t(align)); }
+void operator delete[](void* p, std::align_val_t align) noexcept { allocation::release(p, std::size_t(align)); }
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept { allocation::release(p, std::size_t(align)); }
+void operator delete[](void* p, std::size_t, std::align_val_t align) noexcept { allocation::release(p, std::size_t(align)); }
+
+// ---------- Cache-miss counter ----------
+
+// Hardware cache misses of this process via perf_event_open. Unavailable on
+// non-Linux systems and where perf events are restricted (containers,
+// perf_event_paranoid); the report then shows "n/a".
+class CacheMissCounter {
+private:
+    int fd;
+
+public:
+    CacheMissCounter() : fd(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    bool available() const {
+        return fd >= 0;
+    }
+
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    // Misses since start(), or -1 if the counter is unavailable
+    long long stop() {
+#ifdef __linux__
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        long long count = 0;
+        if (read(fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) return -1;
+        return count;
+#else
+        return -1;
+#endif
+    }
+};
+
+// ---------- Graphs ----------
+
+// Undirected weighted graph in CSR form: the arcs of u are
+// [offsets[u], offsets[u + 1]) in targets/weights, each edge stored both ways.
+struct Graph {
+    std::string name;
+    uint32_t vertexCount;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> targets;
+    std::vector<uint32_t> weights;
+
+    std::size_t edgeCount() const {
+        return targets.size() / 2;
+    }
+};
+
+struct EdgeRecord {
+    uint32_t u, v, w;
+};
+
+Graph buildGraph(const std::string& name, uint32_t vertexCount, const std::vector<EdgeRecord>& edges) {
+    Graph g;
+    g.name = name;
+    g.vertexCount = vertexCount;
+    g.offsets.assign(vertexCount + 1, 0);
+    for (const EdgeRecord& e : edges) {
+        g.offsets[e.u + 1]++;
+        g.offsets[e.v + 1]++;
+    }
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        g.offsets[i + 1] += g.offsets[i];
+    }
+    g.targets.resize(edges.size() * 2);
+    g.weights.resize(edges.size() * 2);
+    std::vector<uint32_t> next(g.offsets.begin(), g.offsets.end() - 1);
+    for (const EdgeRecord& e : edges) {
+        g.targets[next[e.u]] = e.v;
+        g.weights[next[e.u]++] = e.w;
+        g.targets[next[e.v]] = e.u;
+        g.weights[next[e.v]++] = e.w;
+    }
+    return g;
+}
+
+uint32_t randomWeight(std::mt19937_64& rng) {
+    return 1 + static_cast<uint32_t>(rng() % 1000);
+}
+
+// Square 4-neighbour grid: long shortest paths, small frontier
+Graph makeGrid(std::size_t edges, std::mt19937_64& rng) {
+    uint32_t side = std::max<uint32_t>(2, static_cast<uint32_t>(std::sqrt(edges / 2.0)));
+    std::vector<EdgeRecord> list;
+    list.reserve(2ull * side * side);
+    for (uint32_t r = 0; r < side; ++r) {
+        for (uint32_t c = 0; c < side; ++c) {
+            uint32_t u = r * side + c;
+            if (c + 1 < side) list.push_back({u, u + 1, randomWeight(rng)});
+            if (r + 1 < side) list.push_back({u, u + side, randomWeight(rng)});
+        }
+    }
+    return buildGraph("grid", side * side, list);
+}
+
+// Uniform random graph with average degree 8
+Graph makeRandomSparse(std::size_t edges, std::mt19937_64& rng) {
+    uint32_t n = static_cast<uint32_t>(std::max<std::size_t>(2, edges / 4));
+    std::vector<EdgeRecord> list;
+    list.reserve(edges);
+    while (list.size() < edges) {
+        uint32_t u = static_cast<uint32_t>(rng() % n);
+        uint32_t v = static_cast<uint32_t>(rng() % n);
+        if (u != v) list.push_back({u, v, randomWeight(rng)});
+    }
+    return buildGraph("random sparse", n, list);
+}
+
+// Preferential attachment (Barabasi-Albert): each new vertex links to 4
+// endpoints of existing edges, so degrees follow a power law with a few hubs
+Graph makePowerLaw(std::size_t edges, std::mt19937_64& rng) {
+    const uint32_t links = 4;
+    const uint32_t seed = links + 1;
+    uint32_t n = static_cast<uint32_t>(std::max<std::size_t>(seed + 1, edges / links));
+    std::vector<EdgeRecord> list;
+    std::vector<uint32_t> endpoints;
+    list.reserve(std::size_t(n) * links);
+    endpoints.reserve(std::size_t(n) * links * 2);
+    for (uint32_t u = 0; u < seed; ++u) {
+        for (uint32_t v = u + 1; v < seed; ++v) {
+            list.push_back({u, v, randomWeight(rng)});
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    for (uint32_t u = seed; u < n; ++u) {
+        for (uint32_t k = 0; k < links; ++k) {
+            uint32_t v = endpoints[rng() % endpoints.size()];
+            list.push_back({u, v, randomWeight(rng)});
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    return buildGraph("power-law", n, list);
+}
+
+// Complete graph: few vertices, many decrease-key calls per extraction
+Graph makeDense(std::size_t edges, std::mt19937_64& rng) {
+    uint32_t n = std::max<uint32_t>(2, static_cast<uint32_t>((1 + std::sqrt(1 + 8.0 * edges)) / 2));
+    std::vector<EdgeRecord> list;
+    list.reserve(std::size_t(n) * (n - 1) / 2);
+    for (uint32_t u = 0; u < n; ++u) {
+        for (uint32_t v = u + 1; v < n; ++v) {
+            list.push_back({u, v, randomWeight(rng)});
+        }
+    }
+    return buildGraph("dense", n, list);
+}
+
+// ---------- The common decrease-key interface ----------
+
+// Every queue below offers the same operations on vertices 0..n-1, each of
+// which enters the queue at most once per run:
+//   push(v, key)         v enters the queue with `key`
+//   decreaseKey(v, key)  `key` is smaller than v's current key
+//   pop(v, key)          removes the minimum; returns false once empty
+
+// Heap element for the heaps that store plain values: ties on key are broken
+// by vertex, so entries are unique (the treap needs that) and ordering is total
+struct Entry {
+    uint64_t key;
+    uint32_t vertex;
+};
+
+bool operator<(const Entry& a, const Entry& b) {
+    return a.key < b.key || (a.key == b.key && a.vertex < b.vertex);
+}
+bool operator>(const Entry& a, const Entry& b) { return b < a; }
+bool operator<=(const Entry& a, const Entry& b) { return !(b < a); }
+bool operator>=(const Entry& a, const Entry& b) { return !(a < b); }
+bool operator==(const Entry& a, const Entry& b) { return a.key == b.key && a.vertex == b.vertex; }
+bool operator!=(const Entry& a, const Entry& b) { return !(a == b); }
+
+// Uniform insert/extractMin/isEmpty over the value heaps
+struct StdHeap {
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    explicit StdHeap(std::size_t) {}
+    void insert(const Entry& e) { heap.push(e); }
+    Entry extractMin() { Entry e = heap.top(); heap.pop(); return e; }
+    bool isEmpty() const { return heap.empty(); }
+};
+
+struct BinaryHeapAdapter {
+    minheap::MinHeap<Entry> heap;
+    explicit BinaryHeapAdapter(std::size_t) {}
+    void insert(const Entry& e) { heap.insert(e); }
+    Entry extractMin() { return heap.extractMin(); }
+    bool isEmpty() { return heap.size() == 0; }
+};
+
+// 16-byte entries, so each group of 4 siblings fills one cache line
+struct DaryHeapAdapter {
+    dary::DaryHeap<Entry, 4> heap;
+    explicit DaryHeapAdapter(std::size_t) {}
+    void insert(const Entry& e) { heap.insert(e); }
+    Entry extractMin() { return heap.extractMin(); }
+    bool isEmpty() const { return heap.isEmpty(); }
+};
+
+struct BinomialHeapAdapter {
+    binomial::BinomialHeap<Entry> heap;
+    explicit BinomialHeapAdapter(std::size_t) {}
+    void insert(const Entry& e) { heap.insert(e); }
+    Entry extractMin() { return heap.extractMin(); }
+    bool isEmpty() const { return heap.isEmpty(); }
+};
+
+// Decrease-key by re-insertion, for heaps that cannot reach a vertex's entry:
+// the array heaps take a position that moves on every swap, and the binomial
+// heap hands out no node handles. A smaller key is pushed as a duplicate and
+// stale entries are skipped when they reach the top.
+template <typename Heap>
+class LazyQueue {
+private:
+    Heap heap;
+    std::vector<uint64_t> current;
+    std::vector<bool> popped;
+
+public:
+    LazyQueue(uint32_t vertexCount, std::size_t maxEntries)
+        : heap(maxEntries), current(vertexCount), popped(vertexCount, false) {}
+
+    void push(uint32_t v, uint64_t key) {
+        current[v] = key;
+        heap.insert({key, v});
+    }
+
+    void decreaseKey(uint32_t v, uint64_t key) {
+        push(v, key);
+    }
+
+    bool pop(uint32_t& v, uint64_t& key) {
+        while (!heap.isEmpty()) {
+            Entry e = heap.extractMin();
+            if (!popped[e.vertex] && e.key == current[e.vertex]) {
+                popped[e.vertex] = true;
+                v = e.vertex;
+                key = e.key;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// True decrease-key through the handles returned by insert
+class FibonacciQueue {
+private:
+    using Heap = fibonacci::FibonacciHeap<uint64_t, uint32_t>;
+    Heap heap;
+    std::vector<Heap::Handle> handles;
+
+public:
+    FibonacciQueue(uint32_t vertexCount, std::size_t) : handles(vertexCount) {}
+
+    void push(uint32_t v, uint64_t key) {
+        handles[v] = heap.insert(key, v);
+    }
+
+    void decreaseKey(uint32_t v, uint64_t key) {
+        heap.decreaseKey(handles[v], key);
+    }
+
+    bool pop(uint32_t& v, uint64_t& key) {
+        if (heap.empty()) return false;
+        std::pair<uint64_t, uint32_t> entry = heap.extractMinEntry();
+        key = entry.first;
+        v = entry.second;
+        return true;
+    }
+};
+
+// True decrease-key through the node handles returned by insert; a vertex's
+// node is freed by the pop that returns it, so no stale handle is ever used
+class PairingQueue {
+private:
+    using Heap = pairing::PairingHeap<Entry>;
+    Heap heap;
+    std::vector<Heap::Handle> handles;
+
+public:
+    PairingQueue(uint32_t vertexCount, std::size_t) : handles(vertexCount, nullptr) {}
+
+    void push(uint32_t v, uint64_t key) {
+        handles[v] = heap.insert({key, v});
+    }
+
+    void decreaseKey(uint32_t v, uint64_t key) {
+        heap.decreaseKey(handles[v], {key, v});
+    }
+
+    bool pop(uint32_t& v, uint64_t& key) {
+        if (heap.isEmpty()) return false;
+        Entry e = heap.deleteMin();
+        v = e.vertex;
+        key = e.key;
+        return true;
+    }
+};
+
+// The treap is a search tree, so decrease-key is remove + insert by key and
+// extract-min is find-leftmost + remove
+class TreapQueue {
+private:
+    treap::Treap<Entry> tree;
+    std::vector<uint64_t> current;
+
+public:
+    TreapQueue(uint32_t vertexCount, std::size_t) : current(vertexCount) {}
+
+    void push(uint32_t v, uint64_t key) {
+        current[v] = key;
+        tree.insert({key, v});
+    }
+
+    void decreaseKey(uint32_t v, uint64_t key) {
+        tree.remove({current[v], v});
+        push(v, key);
+    }
+
+    bool pop(uint32_t& v, uint64_t& key) {
+        if (tree.isEmpty()) return false;
+        Entry e = tree.getMin();
+        tree.remove(e);
+        v = e.vertex;
+        key = e.key;
+        return true;
+    }
+};
+
+// ---------- Algorithms ----------
+
+const uint64_t UNREACHED = std::numeric_limits<uint64_t>::max();
+
+struct OperationCounts {
+    uint64_t pushes = 0;
+    uint64_t decreases = 0;
+    uint64_t pops = 0;
+    uint64_t checksum = 0; // Sum of distances (Dijkstra) or MST weight (Prim)
+
+    uint64_t total() const {
+        return pushes + decreases + pops;
+    }
+};
+
+// Shortest paths from vertex 0; best[] must be all UNREACHED
+template <typename Queue>
+OperationCounts dijkstra(const Graph& g, Queue& queue, std::vector<uint64_t>& best) {
+    OperationCounts ops;
+    best[0] = 0;
+    queue.push(0, 0);
+    ops.pushes++;
+    uint32_t u;
+    uint64_t d;
+    while (queue.pop(u, d)) {
+        ops.pops++;
+        ops.checksum += d;
+        for (uint32_t a = g.offsets[u]; a < g.offsets[u + 1]; ++a) {
+            uint32_t v = g.targets[a];
+            uint64_t candidate = d + g.weights[a];
+            if (candidate < best[v]) {
+                if (best[v] == UNREACHED) {
+                    queue.push(v, candidate);
+                    ops.pushes++;
+                } else {
+                    queue.decreaseKey(v, candidate);
+                    ops.decreases++;
+                }
+                best[v] = candidate;
+            }
+        }
+    }
+    return ops;
+}
+
+// Minimum spanning tree of vertex 0's component; best[] all UNREACHED, inTree[] all false
+template <typename Queue>
+OperationCounts prim(const Graph& g, Queue& queue, std::vector<uint64_t>& best, std::vector<bool>& inTree) {
+    OperationCounts ops;
+    best[0] = 0;
+    queue.push(0, 0);
+    ops.pushes++;
+    uint32_t u;
+    uint64_t key;
+    while (queue.pop(u, key)) {
+        ops.pops++;
+        ops.checksum += key;
+        inTree[u] = true;
+        for (uint32_t a = g.offsets[u]; a < g.offsets[u + 1]; ++a) {
+            uint32_t v = g.targets[a];
+            uint64_t w = g.weights[a];
+            if (!inTree[v] && w < best[v]) {
+                if (best[v] == UNREACHED) {
+                    queue.push(v, w);
+                    ops.pushes++;
+                } else {
+                    queue.decreaseKey(v, w);
+                    ops.decreases++;
+                }
+                best[v] = w;
+            }
+        }
+    }
+    return ops;
+}
+
+// ---------- Measurement ----------
+
+struct Measurement {
+    OperationCounts ops;
+    double seconds;
+    std::size_t peakBytes;
+    long long cacheMisses;
+};
+
+// Times one run. The algorithm's own arrays are allocated before the baseline
+// is taken, so peak memory covers the queue and its bookkeeping only.
+template <typename Queue>
+Measurement measure(const Graph& g, bool runPrim, CacheMissCounter& counter) {
+    std::vector<uint64_t> best(g.vertexCount, UNREACHED);
+    std::vector<bool> inTree(g.vertexCount, false);
+    Measurement m;
+    std::size_t baseline = allocation::current;
+    allocation::peak = baseline;
+    counter.start();
+    auto t0 = std::chrono::steady_clock::now();
+    {
+        Queue queue(g.vertexCount, g.targets.size() + 1);
+        m.ops = runPrim ? prim(g, queue, best, inTree) : dijkstra(g, queue, best);
+    }
+    m.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    m.cacheMisses = counter.stop();
+    m.peakBytes = allocation::peak - baseline;
+    return m;
+}
+
+template <typename Queue>
+void report(const std::string& queueName, const Graph& g, bool runPrim, CacheMissCounter& counter,
+            uint64_t& expectedChecksum) {
+    Measurement m = measure<Queue>(g, runPrim, counter);
+    if (expectedChecksum == UNREACHED) {
+        expectedChecksum = m.ops.checksum;
+    }
+    double ops = static_cast<double>(m.ops.total());
+    std::cout << "  " << std::left << std::setw(28) << queueName << std::setw(10) << (runPrim ? "Prim" : "Dijkstra")
+              << std::right << std::fixed << std::setprecision(1) << std::setw(10) << m.seconds * 1e3
+              << std::setw(10) << m.seconds * 1e9 / ops << std::setw(12);
+    if (m.cacheMisses >= 0) {
+        std::cout << std::setprecision(2) << m.cacheMisses / ops;
+    } else {
+        std::cout << "n/a";
+    }
+    std::cout << std::setprecision(1) << std::setw(11) << m.peakBytes / 1048576.0 << std::setw(12) << m.ops.decreases
+              << (m.ops.checksum == expectedChecksum ? "" : "  CHECKSUM MISMATCH") << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+}
+
+void benchmarkGraph(const Graph& g, CacheMissCounter& counter) {
+    std::cout << "\n=== " << g.name << ": " << g.vertexCount << " vertices, " << g.edgeCount() << " edges ===" << std::endl;
+    std::cout << "  " << std::left << std::setw(28) << "queue" << std::setw(10) << "algorithm" << std::right
+              << std::setw(10) << "ms" << std::setw(10) << "ns/op" << std::setw(12) << "misses/op" << std::setw(11)
+              << "peak MiB" << std::setw(12) << "decreases" << std::endl;
+    for (bool runPrim : {false, true}) {
+        uint64_t expected = UNREACHED;
+        report<LazyQueue<StdHeap>>("std::priority_queue (lazy)", g, runPrim, counter, expected);
+        report<LazyQueue<BinaryHeapAdapter>>("MinHeap (lazy)", g, runPrim, counter, expected);
+        report<LazyQueue<DaryHeapAdapter>>("DaryHeap d=4 (lazy)", g, runPrim, counter, expected);
+        report<LazyQueue<BinomialHeapAdapter>>("BinomialHeap (lazy)", g, runPrim, counter, expected);
+        report<PairingQueue>("PairingHeap (handles)", g, runPrim, counter, expected);
+        report<FibonacciQueue>("FibonacciHeap (handles)", g, runPrim, counter, expected);
+        report<TreapQueue>("Treap (remove + insert)", g, runPrim, counter, expected);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t edges = 1000000;
+    if (argc > 1) {
+        try {
+            edges = std::stoull(argv[1]);
+        } catch (const std::exception&) {
+            std::cerr << "Usage: " << argv[0] << " [edges]" << std::endl;
+            return 1;
+        }
+        if (edges < 16 || edges > 1000000000ull) {
+            std::cerr << "edges must be between 16 and 10^9" << std::endl;
+            return 1;
+        }
+    }
+
+    CacheMissCounter counter;
+    std::cout << "Priority queues on Dijkstra and Prim, ~" << edges << " edges per graph" << std::endl;
+    std::cout << "ns/op and misses/op divide the whole run (edge scans included) by push + decreaseKey + pop calls;"
+              << std::endl << "peak MiB is the queue's own memory" << std::endl;
+    if (!counter.available()) {
+        std::cout << "(hardware cache-miss counter unavailable: perf_event_open failed)" << std::endl;
+    }
+
+    std::mt19937_64 rng(24);
+    // One graph at a time, so only a single graph's memory is live
+    for (int kind = 0; kind < 4; ++kind) {
+        Graph g = kind == 0 ? makeGrid(edges, rng)
+                : kind == 1 ? makeRandomSparse(edges, rng)
+                : kind == 2 ? makePowerLaw(edges, rng)
+                            : makeDense(edges, rng);
+        benchmarkGraph(g, counter);
+    }
+    return 0;
+}
@@ -1,34 +1,44 @@
 #include <iostream>
 #include <string>
 #include <map>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
-class RadixNode
+// Original map-based radix tree; kept as the baseline for the benchmark in main()
+class MapRadixNode
 {
 public:
     std::string prefix;
-    std::map<char, RadixNode *> children;
+    std::map<char, MapRadixNode *> children;
     bool isEnd;
 
-    RadixNode(const std::string &p = "") : prefix(p), isEnd(false) {}
-    ~RadixNode()
+    MapRadixNode(const std::string &p = "") : prefix(p), isEnd(false) {}
+    ~MapRadixNode()
     {
         for (auto &child : children)
             delete child.second;
     }
 };
 
-class RadixTree
+class MapRadixTree
 {
 private:
-    RadixNode *root;
+    MapRadixNode *root;
 
-    void insert(RadixNode *node, const std::string &key, int pos)
+    void insert(MapRadixNode *node, const std::string &key, int pos)
     {
         std::string remaining = key.substr(pos);
         for (auto &[ch, child] : node->children)
         {
             std::string &childPrefix = child->prefix;
-            int i = 0;
+            size_t i = 0;
             while (i < childPrefix.size() && i < remaining.size() && childPrefix[i] == remaining[i])
                 i++;
 
@@ -38,7 +48,7 @@ private:
             if (i < childPrefix.size())
             {
                 // Split child node
-                RadixNode *split = new RadixNode(childPrefix.substr(i));
+                MapRadixNode *split = new MapRadixNode(childPrefix.substr(i));
                 split->children = std::move(child->children);
                 split->isEnd = child->isEnd;
 
@@ -50,7 +60,7 @@ private:
 
             if (i < remaining.size())
             {
-                insert(child, key, pos + i);
+                insert(child, key, pos + int(i));
             }
             else
             {
@@ -60,12 +70,12 @@ private:
         }
 
         // No common prefix found — insert new leaf
-        RadixNode *newLeaf = new RadixNode(remaining);
+        MapRadixNode *newLeaf = new MapRadixNode(remaining);
         newLeaf->isEnd = true;
         node->children[remaining[0]] = newLeaf;
     }
 
-    bool search(RadixNode *node, const std::string &key, int pos)
+    bool search(MapRadixNode *node, const std::string &key, int pos)
     {
         std::string remaining = key.substr(pos);
         for (auto &[ch, child] : node->children)
@@ -75,31 +85,748 @@ private:
             {
                 if (remaining.size() == p.size())
                     return child->isEnd;
-                return search(child, key, pos + p.size());
+                return search(child, key, pos + int(p.size()));
             }
         }
         return false;
     }
 
-    void print(RadixNode *node, const std::string &path, int level = 0)
+public:
+    MapRadixTree() : root(new MapRadixNode()) {}
+    ~MapRadixTree() { delete root; }
+
+    void insert(const std::string &key) { insert(root, key, 0); }
+    bool search(const std::string &key) { return search(root, key, 0); }
+};
+
+// Adaptive Radix Tree (Leis et al., ICDE 2013). Inner nodes grow and shrink
+// between four layouts as their fan-out changes:
+//   Node4   - up to 4 sorted keys, linear scan
+//   Node16  - up to 16 sorted keys, one SSE2 compare finds the child
+//   Node48  - 256-entry byte index into 48 child slots
+//   Node256 - direct array of 256 children
+// Single-child chains are path-compressed; the first MAX_PREFIX bytes of a
+// compressed path live inline in the node and longer paths are checked
+// against a leaf (the hybrid scheme from the paper). Leaves hold the full
+// key, and a key that ends inside the tree hangs off its node as `terminal`,
+// so any byte string (including ones that are prefixes of others) is valid.
+template <typename Value>
+class AdaptiveRadixTree
+{
+private:
+    static constexpr uint32_t MAX_PREFIX = 8;
+    enum NodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+    struct Leaf
+    {
+        std::string key;
+        Value value;
+    };
+
+    struct Node
+    {
+        NodeType type;
+        uint16_t count = 0;      // number of children (not counting terminal)
+        uint32_t prefixLen = 0;  // full length of the compressed path
+        uint8_t prefix[MAX_PREFIX];
+        Leaf *terminal = nullptr; // key ending exactly at this node
+
+        explicit Node(NodeType t) : type(t) {}
+    };
+
+    struct Node4 : Node
+    {
+        uint8_t keys[4];
+        Node *children[4] = {};
+        Node4() : Node(NODE4) {}
+    };
+
+    struct Node16 : Node
+    {
+        uint8_t keys[16];
+        Node *children[16] = {};
+        Node16() : Node(NODE16) {}
+    };
+
+    struct Node48 : Node
+    {
+        uint8_t childIndex[256] = {}; // slot + 1, 0 = empty
+        Node *children[48] = {};
+        Node48() : Node(NODE48) {}
+    };
+
+    struct Node256 : Node
+    {
+        Node *children[256] = {};
+        Node256() : Node(NODE256) {}
+    };
+
+    // Children are tagged pointers: low bit set means Leaf*
+    static bool isLeaf(const Node *p) { return reinterpret_cast<uintptr_t>(p) & 1; }
+    static Leaf *asLeaf(const Node *p) { return reinterpret_cast<Leaf *>(reinterpret_cast<uintptr_t>(p) & ~uintptr_t(1)); }
+    static Node *tag(Leaf *l) { return reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(l) | 1); }
+
+    Node *root = nullptr;
+    size_t numKeys = 0;
+
+    static uint8_t byteAt(const std::string &key, size_t i) { return uint8_t(key[i]); }
+
+    static void destroy(Node *n)
+    {
+        if (!n)
+            return;
+        if (isLeaf(n))
+        {
+            delete asLeaf(n);
+            return;
+        }
+        delete n->terminal;
+        forEachChild(n, [](uint8_t, Node *child) { destroy(child); return true; });
+        switch (n->type)
+        {
+        case NODE4: delete static_cast<Node4 *>(n); break;
+        case NODE16: delete static_cast<Node16 *>(n); break;
+        case NODE48: delete static_cast<Node48 *>(n); break;
+        case NODE256: delete static_cast<Node256 *>(n); break;
+        }
+    }
+
+    // Visits children in byte order; stops early when fn returns false
+    template <typename Fn>
+    static bool forEachChild(Node *n, Fn &&fn)
+    {
+        switch (n->type)
+        {
+        case NODE4:
+        {
+            auto *x = static_cast<Node4 *>(n);
+            for (int i = 0; i < x->count; ++i)
+                if (!fn(x->keys[i], x->children[i])) return false;
+            break;
+        }
+        case NODE16:
+        {
+            auto *x = static_cast<Node16 *>(n);
+            for (int i = 0; i < x->count; ++i)
+                if (!fn(x->keys[i], x->children[i])) return false;
+            break;
+        }
+        case NODE48:
+        {
+            auto *x = static_cast<Node48 *>(n);
+            for (int b = 0; b < 256; ++b)
+                if (x->childIndex[b] && !fn(uint8_t(b), x->children[x->childIndex[b] - 1])) return false;
+            break;
+        }
+        case NODE256:
+        {
+            auto *x = static_cast<Node256 *>(n);
+            for (int b = 0; b < 256; ++b)
+                if (x->children[b] && !fn(uint8_t(b), x->children[b])) return false;
+            break;
+        }
+        }
+        return true;
+    }
+
+    static Node **findChild(Node *n, uint8_t b)
     {
-        std::string full = path + node->prefix;
-        if (node->isEnd)
-            std::cout << std::string(level * 2, ' ') << "- " << full << "\n";
+        switch (n->type)
+        {
+        case NODE4:
+        {
+            auto *x = static_cast<Node4 *>(n);
+            for (int i = 0; i < x->count; ++i)
+                if (x->keys[i] == b) return &x->children[i];
+            return nullptr;
+        }
+        case NODE16:
+        {
+            auto *x = static_cast<Node16 *>(n);
+#ifdef __SSE2__
+            __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(char(b)),
+                                         _mm_loadu_si128(reinterpret_cast<const __m128i *>(x->keys)));
+            int mask = _mm_movemask_epi8(cmp) & ((1 << x->count) - 1);
+            return mask ? &x->children[__builtin_ctz(mask)] : nullptr;
+#else
+            for (int i = 0; i < x->count; ++i)
+                if (x->keys[i] == b) return &x->children[i];
+            return nullptr;
+#endif
+        }
+        case NODE48:
+        {
+            auto *x = static_cast<Node48 *>(n);
+            return x->childIndex[b] ? &x->children[x->childIndex[b] - 1] : nullptr;
+        }
+        case NODE256:
+        {
+            auto *x = static_cast<Node256 *>(n);
+            return x->children[b] ? &x->children[b] : nullptr;
+        }
+        }
+        return nullptr;
+    }
 
-        for (auto &[_, child] : node->children)
-            print(child, full, level + 1);
+    static void copyHeader(Node *dst, const Node *src)
+    {
+        dst->count = src->count;
+        dst->prefixLen = src->prefixLen;
+        std::memcpy(dst->prefix, src->prefix, MAX_PREFIX);
+        dst->terminal = src->terminal;
+    }
+
+    // Inserts into a sorted key/child array of a Node4 or Node16
+    static void insertSorted(uint8_t *keys, Node **children, uint16_t &count, uint8_t b, Node *child)
+    {
+        int pos = 0;
+        while (pos < count && keys[pos] < b)
+            ++pos;
+        std::memmove(keys + pos + 1, keys + pos, count - pos);
+        std::memmove(children + pos + 1, children + pos, (count - pos) * sizeof(Node *));
+        keys[pos] = b;
+        children[pos] = child;
+        ++count;
+    }
+
+    // Adds a child, replacing ref with the next larger node kind when full
+    static void addChild(Node *&ref, uint8_t b, Node *child)
+    {
+        Node *n = ref;
+        switch (n->type)
+        {
+        case NODE4:
+        {
+            auto *x = static_cast<Node4 *>(n);
+            if (x->count < 4)
+            {
+                insertSorted(x->keys, x->children, x->count, b, child);
+                return;
+            }
+            auto *bigger = new Node16();
+            copyHeader(bigger, x);
+            std::memcpy(bigger->keys, x->keys, 4);
+            std::memcpy(bigger->children, x->children, 4 * sizeof(Node *));
+            delete x;
+            ref = bigger;
+            insertSorted(bigger->keys, bigger->children, bigger->count, b, child);
+            return;
+        }
+        case NODE16:
+        {
+            auto *x = static_cast<Node16 *>(n);
+            if (x->count < 16)
+            {
+                insertSorted(x->keys, x->children, x->count, b, child);
+                return;
+            }
+            auto *bigger = new Node48();
+            copyHeader(bigger, x);
+            for (int i = 0; i < 16; ++i)
+            {
+                bigger->children[i] = x->children[i];
+                bigger->childIndex[x->keys[i]] = uint8_t(i + 1);
+            }
+            delete x;
+            ref = bigger;
+            addChild(ref, b, child);
+            return;
+        }
+        case NODE48:
+        {
+            auto *x = static_cast<Node48 *>(n);
+            if (x->count < 48)
+            {
+                int slot = 0;
+                while (x->children[slot])
+                    ++slot;
+                x->children[slot] = child;
+                x->childIndex[b] = uint8_t(slot + 1);
+                ++x->count;
+                return;
+            }
+            auto *bigger = new Node256();
+            copyHeader(bigger, x);
+            for (int c = 0; c < 256; ++c)
+                if (x->childIndex[c])
+                    bigger->children[c] = x->children[x->childIndex[c] - 1];
+            delete x;
+            ref = bigger;
+            addChild(ref, b, child);
+            return;
+        }
+        case NODE256:
+        {
+            auto *x = static_cast<Node256 *>(n);
+            x->children[b] = child;
+            ++x->count;
+            return;
+        }
+        }
+    }
+
+    static void removeChild(Node *n, uint8_t b)
+    {
+        switch (n->type)
+        {
+        case NODE4:
+        case NODE16:
+        {
+            uint8_t *keys = n->type == NODE4 ? static_cast<Node4 *>(n)->keys : static_cast<Node16 *>(n)->keys;
+            Node **children = n->type == NODE4 ? static_cast<Node4 *>(n)->children : static_cast<Node16 *>(n)->children;
+            int pos = 0;
+            while (keys[pos] != b)
+                ++pos;
+            std::memmove(keys + pos, keys + pos + 1, n->count - pos - 1);
+            std::memmove(children + pos, children + pos + 1, (n->count - pos - 1) * sizeof(Node *));
+            --n->count;
+            return;
+        }
+        case NODE48:
+        {
+            auto *x = static_cast<Node48 *>(n);
+            x->children[x->childIndex[b] - 1] = nullptr;
+            x->childIndex[b] = 0;
+            --x->count;
+            return;
+        }
+        case NODE256:
+        {
+            static_cast<Node256 *>(n)->children[b] = nullptr;
+            --n->count;
+            return;
+        }
+        }
+    }
+
+    // After a removal: drop to a smaller node kind, or collapse a node
+    // that no longer branches into its only child or its terminal leaf.
+    static void shrink(Node *&ref)
+    {
+        Node *n = ref;
+        if (n->count == 0)
+        {
+            ref = tag(n->terminal);
+            n->terminal = nullptr;
+            destroy(n);
+            return;
+        }
+        if (n->count == 1 && !n->terminal)
+        {
+            uint8_t b = 0;
+            Node *child = nullptr;
+            forEachChild(n, [&](uint8_t key, Node *c) { b = key; child = c; return false; });
+            if (!isLeaf(child))
+            {
+                // Concatenate prefixes: parent prefix + branch byte + child prefix
+                uint8_t joined[MAX_PREFIX];
+                uint32_t len = 0;
+                for (uint32_t i = 0; i < std::min(n->prefixLen, MAX_PREFIX); ++i)
+                    joined[len++] = n->prefix[i];
+                if (len < MAX_PREFIX && n->prefixLen < MAX_PREFIX)
+                    joined[len++] = b;
+                for (uint32_t i = 0; len < MAX_PREFIX && i < std::min(child->prefixLen, MAX_PREFIX); ++i)
+                    joined[len++] = child->prefix[i];
+                std::memcpy(child->prefix, joined, len);
+                child->prefixLen += n->prefixLen + 1;
+            }
+            n->count = 0;
+            ref = child;
+            destroy(n);
+            return;
+        }
+        if (n->type == NODE16 && n->count <= 3)
+        {
+            auto *x = static_cast<Node16 *>(n);
+            auto *smaller = new Node4();
+            copyHeader(smaller, x);
+            std::memcpy(smaller->keys, x->keys, x->count);
+            std::memcpy(smaller->children, x->children, x->count * sizeof(Node *));
+            delete x;
+            ref = smaller;
+        }
+        else if (n->type == NODE48 && n->count <= 12)
+        {
+            auto *x = static_cast<Node48 *>(n);
+            auto *smaller = new Node16();
+            copyHeader(smaller, x);
+            smaller->count = 0;
+            for (int c = 0; c < 256; ++c)
+                if (x->childIndex[c])
+                {
+                    smaller->keys[smaller->count] = uint8_t(c);
+                    smaller->children[smaller->count++] = x->children[x->childIndex[c] - 1];
+                }
+            delete x;
+            ref = smaller;
+        }
+        else if (n->type == NODE256 && n->count <= 37)
+        {
+            auto *x = static_cast<Node256 *>(n);
+            auto *smaller = new Node48();
+            copyHeader(smaller, x);
+            smaller->count = 0;
+            for (int c = 0; c < 256; ++c)
+                if (x->children[c])
+                {
+                    smaller->children[smaller->count] = x->children[c];
+                    smaller->childIndex[c] = uint8_t(++smaller->count);
+                }
+            delete x;
+            ref = smaller;
+        }
+    }
+
+    // Any leaf below n; all of them share n's full compressed prefix
+    static const Leaf *anyLeaf(const Node *n)
+    {
+        while (!isLeaf(n))
+        {
+            if (n->terminal)
+                return n->terminal;
+            Node *first = nullptr;
+            forEachChild(const_cast<Node *>(n), [&](uint8_t, Node *c) { first = c; return false; });
+            n = first;
+        }
+        return asLeaf(n);
+    }
+
+    // Length of the match between n's compressed path and key[depth..]
+    static uint32_t prefixMismatch(const Node *n, const std::string &key, size_t depth)
+    {
+        uint32_t stored = std::min(n->prefixLen, MAX_PREFIX);
+        uint32_t i = 0;
+        for (; i < stored; ++i)
+            if (depth + i >= key.size() || n->prefix[i] != byteAt(key, depth + i))
+                return i;
+        if (n->prefixLen > MAX_PREFIX)
+        {
+            const std::string &full = anyLeaf(n)->key;
+            for (; i < n->prefixLen; ++i)
+                if (depth + i >= key.size() || full[depth + i] != key[depth + i])
+                    return i;
+        }
+        return i;
+    }
+
+    // Full bytes of n's compressed path (only needed for range scans)
+    static std::string fullPrefix(const Node *n, size_t depth)
+    {
+        if (n->prefixLen <= MAX_PREFIX)
+            return std::string(reinterpret_cast<const char *>(n->prefix), n->prefixLen);
+        return anyLeaf(n)->key.substr(depth, n->prefixLen);
+    }
+
+    // Puts leaf under n at the given depth: as terminal or as a child
+    static void place(Node *&ref, Leaf *leaf, size_t depth)
+    {
+        if (leaf->key.size() == depth)
+            ref->terminal = leaf;
+        else
+            addChild(ref, byteAt(leaf->key, depth), tag(leaf));
+    }
+
+    bool insert(Node *&ref, const std::string &key, size_t depth, const Value &value)
+    {
+        if (!ref)
+        {
+            ref = tag(new Leaf{key, value});
+            return true;
+        }
+
+        if (isLeaf(ref))
+        {
+            Leaf *existing = asLeaf(ref);
+            if (existing->key == key)
+            {
+                existing->value = value;
+                return false;
+            }
+            // Split the leaf: new Node4 whose path is the common part of both keys
+            size_t limit = std::min(existing->key.size(), key.size());
+            size_t common = depth;
+            while (common < limit && existing->key[common] == key[common])
+                ++common;
+
+            Node *branch = new Node4();
+            branch->prefixLen = uint32_t(common - depth);
+            std::memcpy(branch->prefix, key.data() + depth, std::min<size_t>(branch->prefixLen, MAX_PREFIX));
+            place(branch, existing, common);
+            place(branch, new Leaf{key, value}, common);
+            ref = branch;
+            return true;
+        }
+
+        Node *n = ref;
+        if (n->prefixLen)
+        {
+            uint32_t p = prefixMismatch(n, key, depth);
+            if (p < n->prefixLen)
+            {
+                // Split the compressed path at the first differing byte
+                Node *branch = new Node4();
+                branch->prefixLen = p;
+                std::memcpy(branch->prefix, n->prefix, std::min(p, MAX_PREFIX));
+
+                if (n->prefixLen <= MAX_PREFIX)
+                {
+                    uint8_t b = n->prefix[p];
+                    n->prefixLen -= p + 1;
+                    std::memmove(n->prefix, n->prefix + p + 1, n->prefixLen);
+                    addChild(branch, b, n);
+                }
+                else
+                {
+                    const std::string &full = anyLeaf(n)->key;
+                    uint8_t b = byteAt(full, depth + p);
+                    n->prefixLen -= p + 1;
+                    std::memcpy(n->prefix, full.data() + depth + p + 1, std::min(n->prefixLen, MAX_PREFIX));
+                    addChild(branch, b, n);
+                }
+                place(branch, new Leaf{key, value}, depth + p);
+                ref = branch;
+                return true;
+            }
+            depth += n->prefixLen;
+        }
+
+        if (depth == key.size())
+        {
+            if (n->terminal)
+            {
+                n->terminal->value = value;
+                return false;
+            }
+            n->terminal = new Leaf{key, value};
+            return true;
+        }
+
+        if (Node **child = findChild(n, byteAt(key, depth)))
+            return insert(*child, key, depth + 1, value);
+
+        addChild(ref, byteAt(key, depth), tag(new Leaf{key, value}));
+        return true;
+    }
+
+    bool erase(Node *&ref, const std::string &key, size_t depth)
+    {
+        if (!ref)
+            return false;
+        if (isLeaf(ref))
+        {
+            if (asLeaf(ref)->key != key)
+                return false;
+            delete asLeaf(ref);
+            ref = nullptr;
+            return true;
+        }
+
+        Node *n = ref;
+        if (n->prefixLen)
+        {
+            if (prefixMismatch(n, key, depth) < n->prefixLen)
+                return false;
+            depth += n->prefixLen;
+        }
+
+        if (depth == key.size())
+        {
+            if (!n->terminal)
+                return false;
+            delete n->terminal;
+            n->terminal = nullptr;
+            shrink(ref);
+            return true;
+        }
+
+        uint8_t b = byteAt(key, depth);
+        Node **child = findChild(n, b);
+        if (!child)
+            return false;
+        if (isLeaf(*child))
+        {
+            if (asLeaf(*child)->key != key)
+                return false;
+            delete asLeaf(*child);
+            removeChild(n, b);
+            shrink(ref);
+            return true;
+        }
+        return erase(*child, key, depth + 1);
+    }
+
+    // In-order walk over keys >= lo and < hi (when given). onLowPath means
+    // every byte above this subtree equals lo, so lo still prunes it.
+    template <typename Fn>
+    static bool scan(const Node *n, size_t depth, const std::string &lo, bool onLowPath, const std::string *hi, Fn &fn)
+    {
+        if (isLeaf(n))
+        {
+            const Leaf *leaf = asLeaf(n);
+            if (onLowPath && leaf->key < lo)
+                return true;
+            if (hi && !(leaf->key < *hi))
+                return false;
+            fn(leaf->key, leaf->value);
+            return true;
+        }
+
+        if (onLowPath && lo.size() <= depth)
+            onLowPath = false; // lo is a prefix of every key below
+        if (onLowPath && n->prefixLen)
+        {
+            std::string path = fullPrefix(n, depth);
+            size_t k = std::min(path.size(), lo.size() - depth);
+            int cmp = lo.compare(depth, k, path, 0, k);
+            if (cmp > 0)
+                return true; // whole subtree sorts before lo
+            if (cmp < 0 || k < path.size())
+                onLowPath = false;
+        }
+        depth += n->prefixLen;
+
+        if (const Leaf *leaf = n->terminal)
+        {
+            if (!(onLowPath && leaf->key < lo))
+            {
+                if (hi && !(leaf->key < *hi))
+                    return false;
+                fn(leaf->key, leaf->value);
+            }
+        }
+
+        bool bounded = onLowPath && depth < lo.size();
+        uint8_t loByte = bounded ? byteAt(lo, depth) : 0;
+        return forEachChild(const_cast<Node *>(n), [&](uint8_t b, Node *child) {
+            if (bounded && b < loByte)
+                return true;
+            return scan(child, depth + 1, lo, bounded && b == loByte, hi, fn);
+        });
     }
 
 public:
-    RadixTree() : root(new RadixNode()) {}
-    ~RadixTree() { delete root; }
+    AdaptiveRadixTree() = default;
+    ~AdaptiveRadixTree() { destroy(root); }
+    AdaptiveRadixTree(const AdaptiveRadixTree &) = delete;
+    AdaptiveRadixTree &operator=(const AdaptiveRadixTree &) = delete;
 
-    void insert(const std::string &key) { insert(root, key, 0); }
-    bool search(const std::string &key) { return search(root, key, 0); }
-    void print() { print(root, ""); }
+    // Returns true if the key is new; an existing key gets its value replaced
+    bool insert(const std::string &key, const Value &value)
+    {
+        bool added = insert(root, key, 0, value);
+        numKeys += added;
+        return added;
+    }
+
+    const Value *find(const std::string &key) const
+    {
+        const Node *n = root;
+        size_t depth = 0;
+        while (n)
+        {
+            if (isLeaf(n))
+                return asLeaf(n)->key == key ? &asLeaf(n)->value : nullptr;
+
+            // Optimistic: only the inline prefix bytes are checked here,
+            // the full key is verified at the leaf
+            uint32_t stored = std::min(n->prefixLen, MAX_PREFIX);
+            for (uint32_t i = 0; i < stored; ++i)
+                if (depth + i >= key.size() || n->prefix[i] != byteAt(key, depth + i))
+                    return nullptr;
+            depth += n->prefixLen;
+
+            if (depth >= key.size())
+            {
+                if (depth == key.size() && n->terminal && n->terminal->key == key)
+                    return &n->terminal->value;
+                return nullptr;
+            }
+            Node *const *child = findChild(const_cast<Node *>(n), byteAt(key, depth));
+            if (!child)
+                return nullptr;
+            n = *child;
+            ++depth;
+        }
+        return nullptr;
+    }
+
+    bool erase(const std::string &key)
+    {
+        bool removed = erase(root, key, 0);
+        numKeys -= removed;
+        return removed;
+    }
+
+    size_t size() const { return numKeys; }
+
+    // Calls fn(key, value) in key order for lo <= key < hi
+    template <typename Fn>
+    void range(const std::string &lo, const std::string &hi, Fn fn) const
+    {
+        if (root)
+            scan(root, 0, lo, true, &hi, fn);
+    }
+
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        if (root)
+            scan(root, 0, std::string(), false, nullptr, fn);
+    }
+};
+
+// String set built on the ART engine
+class RadixTree
+{
+private:
+    AdaptiveRadixTree<bool> art;
+
+public:
+    void insert(const std::string &key) { art.insert(key, true); }
+    bool search(const std::string &key) const { return art.find(key) != nullptr; }
+    bool remove(const std::string &key) { return art.erase(key); }
+    size_t size() const { return art.size(); }
+
+    template <typename Fn>
+    void range(const std::string &lo, const std::string &hi, Fn fn) const
+    {
+        art.range(lo, hi, [&](const std::string &key, bool) { fn(key); });
+    }
+
+    void print() const
+    {
+        art.forEach([](const std::string &key, bool) { std::cout << "- " << key << "\n"; });
+    }
 };
 
+// ---------- Benchmark: ART vs. the map-based radix tree ----------
+
+template <typename F>
+double timeMs(F &&f)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void benchmark(const std::string &name, const std::vector<std::string> &keys)
+{
+    MapRadixTree mapTree;
+    RadixTree artTree;
+    size_t mapHits = 0, artHits = 0;
+
+    double mapInsert = timeMs([&] { for (const auto &k : keys) mapTree.insert(k); });
+    double artInsert = timeMs([&] { for (const auto &k : keys) artTree.insert(k); });
+    double mapLookup = timeMs([&] { for (const auto &k : keys) mapHits += mapTree.search(k); });
+    double artLookup = timeMs([&] { for (const auto &k : keys) artHits += artTree.search(k); });
+
+    auto perKey = [&](double ms) { return ms * 1e6 / double(keys.size()); };
+    std::cout << "  " << name << " (" << keys.size() << " keys)\n"
+              << "    map-based insert: " << perKey(mapInsert) << " ns/key, lookup: " << perKey(mapLookup) << " ns/key\n"
+              << "    ART insert:       " << perKey(artInsert) << " ns/key, lookup: " << perKey(artLookup) << " ns/key\n"
+              << "    hits agree:       " << (mapHits == artHits && artHits == keys.size() ? "yes" : "NO") << "\n";
+}
+
 int main()
 {
     RadixTree tree;
@@ -117,5 +844,31 @@ int main()
     for (const std::string &word : {"test", "team", "toast", "tester", "testing", "toaster"})
         std::cout << word << ": " << (tree.search(word) ? "Found" : "Not Found") << "\n";
 
+    std::cout << "\nKeys in [\"tes\", \"testing\"):\n";
+    tree.range("tes", "testing", [](const std::string &key) { std::cout << "- " << key << "\n"; });
+
+    tree.remove("tester");
+    std::cout << "\nAfter removing 'tester': " << (tree.search("tester") ? "Found" : "Not Found")
+              << ", 'test' still " << (tree.search("test") ? "Found" : "Not Found") << "\n";
+
+    std::cout << "\n--- Benchmark ---\n";
+    std::mt19937 rng(11);
+    const char *hosts[] = {"example.com", "shop.example.com", "api.internal.net", "cdn.static.org"};
+    const char *dirs[] = {"users", "orders", "products", "images", "v1/search", "v2/search"};
+    std::vector<std::string> urls, ids;
+    while (urls.size() < 200000)
+        urls.push_back(std::string("https://") + hosts[rng() % 4] + "/" + dirs[rng() % 6] + "/" +
+                       std::to_string(rng() % 1000000) + "?page=" + std::to_string(rng() % 50));
+    while (ids.size() < 200000)
+        ids.push_back("user:" + std::to_string(10000000 + rng() % 90000000));
+    for (auto *keys : {&urls, &ids})
+    {
+        std::sort(keys->begin(), keys->end());
+        keys->erase(std::unique(keys->begin(), keys->end()), keys->end());
+        std::shuffle(keys->begin(), keys->end(), rng);
+    }
+    benchmark("URLs", urls);
+    benchmark("IDs", ids);
+
     return 0;
 }
@@ -1,5 +1,12 @@
 #include <iostream>
 #include <string>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <utility>
 
 const int ALPHABET_SIZE = 26;
 
@@ -7,8 +14,9 @@ class TrieNode {
 public:
     TrieNode* children[ALPHABET_SIZE];
     bool isEnd;
+    uint32_t score;
 
-    TrieNode() : isEnd(false) {
+    TrieNode() : isEnd(false), score(0) {
         for (int i = 0; i < ALPHABET_SIZE; i++) children[i] = nullptr;
     }
 
@@ -22,6 +30,7 @@ public:
 class Trie {
 private:
     TrieNode* root;
+    size_t nodes = 1;
 
     void print(TrieNode* node, std::string prefix) {
         if (node->isEnd) std::cout << prefix << "\n";
@@ -31,19 +40,34 @@ private:
         }
     }
 
+    void collect(const TrieNode* node, std::string& prefix,
+                 std::vector<std::pair<std::string, uint32_t>>& out) const {
+        if (node->isEnd) out.emplace_back(prefix, node->score);
+        for (int i = 0; i < ALPHABET_SIZE; i++) {
+            if (!node->children[i]) continue;
+            prefix.push_back(char('a' + i));
+            collect(node->children[i], prefix, out);
+            prefix.pop_back();
+        }
+    }
+
 public:
     Trie() : root(new TrieNode()) {}
     ~Trie() { delete root; }
 
-    void insert(const std::string& word) {
+    void insert(const std::string& word, uint32_t score = 1) {
         TrieNode* node = root;
         for (char c : word) {
             if (c < 'a' || c > 'z') continue; // skip invalid chars
             int index = c - 'a';
-            if (!node->children[index]) node->children[index] = new TrieNode();
+            if (!node->children[index]) {
+                node->children[index] = new TrieNode();
+                nodes++;
+            }
             node = node->children[index];
         }
         node->isEnd = true;
+        node->score = score;
     }
 
     bool search(const std::string& word) {
@@ -68,11 +92,337 @@ public:
         return true;
     }
 
+    // All stored words with their scores, in lexicographic order.
+    std::vector<std::pair<std::string, uint32_t>> words() const {
+        std::vector<std::pair<std::string, uint32_t>> out;
+        std::string prefix;
+        collect(root, prefix, out);
+        return out;
+    }
+
+    size_t nodeCount() const { return nodes; }
+    size_t bytes() const { return nodes * sizeof(TrieNode); }
+
     void print() {
         print(root, "");
     }
 };
 
+/*
+ * CompactTrie: a static double-array trie over arbitrary bytes, built
+ * once from the mutable Trie (or any word list) for read-only serving.
+ *
+ * Every node is a slot in two parallel arrays. A transition from node s
+ * on byte c lands in slot t = base[s] + c + 1 and is valid only if
+ * check[t] == s, so a lookup step is one addition and one 8-byte load
+ * instead of chasing a pointer out of a 216-byte node. check[] doubles
+ * as the parent link, which lets topK() rebuild words without storing
+ * them.
+ *
+ * Each node also caches the best score in its subtree. topK() runs a
+ * best-first search ordered by that bound and stops after k words, so it
+ * never touches subtrees that cannot make the cut.
+ */
+class CompactTrie {
+private:
+    struct Unit {
+        int32_t base;   // children live at base + label
+        int32_t check;  // parent slot, -1 if the slot is free
+    };
+
+    // Cold per-node data, only read by topK() and enumeration.
+    struct Meta {
+        uint32_t maxScore;  // best score anywhere in this subtree
+        uint32_t score;     // this node's own score if it ends a word
+        uint16_t child;     // label of the first child, 0 if none
+        uint16_t sibling;   // label of the next sibling, 0 if none
+    };
+
+    static constexpr uint16_t TERMINAL = 0x8000;  // flag in Meta::child
+    static constexpr uint16_t LABEL_MASK = 0x01FF;
+
+    std::vector<Unit> units;
+    std::vector<Meta> meta;
+    size_t nodes = 0;
+
+    // Build-time free list over unused slots (circular, doubly linked).
+    std::vector<int32_t> nextFree, prevFree;
+    std::vector<uint8_t> used;
+    int32_t freeHead = -1;
+
+    static uint16_t label(unsigned char c) { return uint16_t(c) + 1; }
+
+    void grow(size_t newSize) {
+        size_t old = units.size();
+        if (newSize <= old) return;
+        units.resize(newSize, Unit{0, -1});
+        meta.resize(newSize, Meta{0, 0, 0, 0});
+        nextFree.resize(newSize);
+        prevFree.resize(newSize);
+        used.resize(newSize, 0);
+        for (size_t i = old; i < newSize; i++) {
+            int32_t slot = int32_t(i);
+            if (freeHead < 0) {
+                freeHead = nextFree[slot] = prevFree[slot] = slot;
+                continue;
+            }
+            int32_t tail = prevFree[freeHead];
+            nextFree[tail] = slot;
+            prevFree[slot] = tail;
+            nextFree[slot] = freeHead;
+            prevFree[freeHead] = slot;
+        }
+    }
+
+    void take(int32_t slot) {
+        used[slot] = 1;
+        if (nextFree[slot] == slot) {
+            freeHead = -1;
+            return;
+        }
+        nextFree[prevFree[slot]] = nextFree[slot];
+        prevFree[nextFree[slot]] = prevFree[slot];
+        if (freeHead == slot) freeHead = nextFree[slot];
+    }
+
+    // First base at which every child label lands on a free slot.
+    int32_t findBase(const std::vector<uint16_t>& labels) {
+        if (freeHead < 0) grow(units.size() * 2 + LABEL_MASK);
+        int32_t f = freeHead;
+        while (true) {
+            int32_t b = f - labels.front();
+            if (b >= 0) {
+                size_t last = size_t(b) + labels.back();
+                if (last >= units.size()) grow(std::max(units.size() * 2, last + 1));
+                bool fits = true;
+                for (uint16_t c : labels) {
+                    if (used[b + c]) { fits = false; break; }
+                }
+                if (fits) return b;
+            }
+            if (nextFree[f] == freeHead) grow(units.size() * 2);
+            f = nextFree[f];
+        }
+    }
+
+    // Lays out the subtree for words[lo, hi), which all share their first
+    // `depth` bytes and hang under slot s. Returns the subtree's max score.
+    uint32_t build(const std::vector<std::pair<std::string, uint32_t>>& words,
+                   size_t lo, size_t hi, size_t depth, int32_t s) {
+        Meta m{0, 0, 0, 0};
+        if (lo < hi && words[lo].first.size() == depth) {
+            m.child |= TERMINAL;
+            m.score = m.maxScore = words[lo].second;
+            lo++;
+        }
+
+        std::vector<uint16_t> labels;
+        std::vector<size_t> bounds;
+        for (size_t i = lo; i < hi; i++) {
+            uint16_t c = label(words[i].first[depth]);
+            if (labels.empty() || labels.back() != c) {
+                labels.push_back(c);
+                bounds.push_back(i);
+            }
+        }
+        bounds.push_back(hi);
+
+        if (!labels.empty()) {
+            int32_t b = findBase(labels);
+            units[s].base = b;
+            for (uint16_t c : labels) {
+                take(b + c);
+                units[b + c].check = s;
+                nodes++;
+            }
+            m.child |= labels.front();
+            for (size_t i = 0; i < labels.size(); i++) {
+                int32_t t = b + labels[i];
+                uint32_t best = build(words, bounds[i], bounds[i + 1], depth + 1, t);
+                meta[t].sibling = i + 1 < labels.size() ? labels[i + 1] : 0;
+                m.maxScore = std::max(m.maxScore, best);
+            }
+        }
+
+        meta[s] = m;  // the parent fills in sibling once this returns
+        return m.maxScore;
+    }
+
+    // Slot reached by following `key` from the root, or -1.
+    int32_t walk(const std::string& key) const {
+        int32_t s = 0;
+        for (unsigned char c : key) {
+            size_t t = size_t(units[s].base) + label(c);
+            if (t >= units.size() || units[t].check != s) return -1;
+            s = int32_t(t);
+        }
+        return s;
+    }
+
+    // Bytes on the path from `top` down to `s`, rebuilt through check[].
+    std::string suffix(int32_t s, int32_t top) const {
+        std::string out;
+        while (s != top) {
+            int32_t parent = units[s].check;
+            out.push_back(char(s - units[parent].base - 1));
+            s = parent;
+        }
+        std::reverse(out.begin(), out.end());
+        return out;
+    }
+
+public:
+    // Freezes a mutable trie. Only the 26-letter alphabet survives, since
+    // that is all the source can hold.
+    explicit CompactTrie(const Trie& trie) : CompactTrie(trie.words()) {}
+
+    // Builds from any byte strings; duplicates keep their highest score.
+    explicit CompactTrie(std::vector<std::pair<std::string, uint32_t>> words) {
+        std::sort(words.begin(), words.end(), [](const auto& a, const auto& b) {
+            return a.first != b.first ? a.first < b.first : a.second > b.second;
+        });
+        words.erase(std::unique(words.begin(), words.end(),
+                                [](const auto& a, const auto& b) { return a.first == b.first; }),
+                    words.end());
+
+        grow(LABEL_MASK + 1);
+        take(0);
+        units[0].check = -2;  // root is its own parent-less slot
+        nodes = 1;
+        build(words, 0, words.size(), 0, 0);
+
+        // Trim unused tail slots and drop the build-only state.
+        size_t end = units.size();
+        while (end > 1 && !used[end - 1]) end--;
+        units.resize(end);
+        meta.resize(end);
+        units.shrink_to_fit();
+        meta.shrink_to_fit();
+        std::vector<int32_t>().swap(nextFree);
+        std::vector<int32_t>().swap(prevFree);
+        std::vector<uint8_t>().swap(used);
+    }
+
+    bool search(const std::string& word) const {
+        int32_t s = walk(word);
+        return s >= 0 && (meta[s].child & TERMINAL);
+    }
+
+    bool startsWith(const std::string& prefix) const {
+        return walk(prefix) >= 0;
+    }
+
+    // The k highest-scoring words that start with `prefix`, best first.
+    std::vector<std::pair<std::string, uint32_t>> topK(const std::string& prefix, size_t k) const {
+        std::vector<std::pair<std::string, uint32_t>> out;
+        int32_t top = walk(prefix);
+        if (top < 0 || k == 0) return out;
+
+        // Entry: (score bound, slot, isWord). A word entry's bound is its
+        // exact score, so once it reaches the front nothing left can beat it.
+        using Entry = std::pair<uint64_t, int32_t>;
+        auto key = [](uint32_t score, bool isWord) { return (uint64_t(score) << 1) | isWord; };
+        std::priority_queue<Entry> frontier;
+        frontier.push({key(meta[top].maxScore, false), top});
+
+        while (!frontier.empty() && out.size() < k) {
+            auto [bound, s] = frontier.top();
+            frontier.pop();
+            if (bound & 1) {
+                out.emplace_back(prefix + suffix(s, top), meta[s].score);
+                continue;
+            }
+            const Meta& m = meta[s];
+            if (m.child & TERMINAL) frontier.push({key(m.score, true), s});
+            for (uint16_t c = m.child & LABEL_MASK; c != 0;) {
+                int32_t t = units[s].base + c;
+                frontier.push({key(meta[t].maxScore, false), t});
+                c = meta[t].sibling;
+            }
+        }
+        return out;
+    }
+
+    size_t nodeCount() const { return nodes; }
+    size_t slotCount() const { return units.size(); }
+    size_t bytes() const { return units.size() * (sizeof(Unit) + sizeof(Meta)); }
+};
+
+// ---------- Benchmark: pointer trie vs. double-array trie ----------
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void benchmark(size_t wordCount) {
+    const char* syllables[] = {"con", "pre", "ing", "tion", "ex", "per", "ma", "ter", "re", "al",
+                               "in", "de", "com", "pro", "ly", "ment", "ness", "st", "ar", "ble"};
+    std::mt19937 rng(7);
+    std::vector<std::string> words;
+    while (words.size() < wordCount) {
+        std::string w;
+        for (int n = 2 + rng() % 4; n > 0; n--) w += syllables[rng() % 20];
+        words.push_back(w);
+    }
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    // Zipf-like popularity: a handful of words dominate, as in query logs.
+    std::vector<std::pair<std::string, uint32_t>> scored;
+    for (const auto& w : words) scored.emplace_back(w, uint32_t(1000000 / (1 + rng() % 100000)));
+
+    Trie trie;
+    double buildMutable = timeMs([&] { for (const auto& [w, s] : scored) trie.insert(w, s); });
+    CompactTrie* compact = nullptr;
+    double buildCompact = timeMs([&] { compact = new CompactTrie(trie); });
+
+    std::vector<std::string> queries = words;
+    std::shuffle(queries.begin(), queries.end(), rng);
+    size_t trieHits = 0, compactHits = 0;
+    double trieLookup = timeMs([&] { for (const auto& q : queries) trieHits += trie.search(q); });
+    double compactLookup = timeMs([&] { for (const auto& q : queries) compactHits += compact->search(q); });
+
+    // topK against a scan of the sorted word range under each prefix.
+    std::vector<std::string> prefixes;
+    for (size_t i = 0; i < 2000; i++) prefixes.push_back(queries[i].substr(0, 2 + i % 4));
+    size_t agree = 0;
+    double scanMs = 0, topKMs = 0;
+    for (const auto& p : prefixes) {
+        std::vector<std::pair<std::string, uint32_t>> expect, got;
+        scanMs += timeMs([&] {
+            auto lo = std::lower_bound(scored.begin(), scored.end(), std::make_pair(p, 0u));
+            std::vector<uint32_t> scores;
+            for (auto it = lo; it != scored.end() && it->first.compare(0, p.size(), p) == 0; ++it)
+                scores.push_back(it->second);
+            std::sort(scores.rbegin(), scores.rend());
+            scores.resize(std::min<size_t>(scores.size(), 10));
+            for (uint32_t s : scores) expect.emplace_back("", s);
+        });
+        topKMs += timeMs([&] { got = compact->topK(p, 10); });
+        bool same = got.size() == expect.size();
+        for (size_t i = 0; same && i < got.size(); i++)
+            same = got[i].second == expect[i].second && got[i].first.compare(0, p.size(), p) == 0;
+        agree += same;
+    }
+
+    auto perKey = [&](double ms) { return ms * 1e6 / double(queries.size()); };
+    std::cout << "  " << words.size() << " words, " << trie.nodeCount() << " trie nodes\n"
+              << "    pointer trie:  " << trie.bytes() / (1 << 20) << " MiB, build " << buildMutable
+              << " ms, lookup " << perKey(trieLookup) << " ns/key\n"
+              << "    double-array:  " << compact->bytes() / (1 << 20) << " MiB ("
+              << compact->slotCount() << " slots), freeze " << buildCompact
+              << " ms, lookup " << perKey(compactLookup) << " ns/key\n"
+              << "    memory ratio:  " << double(trie.bytes()) / double(compact->bytes()) << "x\n"
+              << "    hits agree:    " << (trieHits == compactHits && compactHits == queries.size() ? "yes" : "NO") << "\n"
+              << "    top-10 over " << prefixes.size() << " prefixes: scan " << scanMs * 1000 / prefixes.size()
+              << " us, topK " << topKMs * 1000 / prefixes.size() << " us, agree "
+              << agree << "/" << prefixes.size() << "\n";
+    delete compact;
+}
+
 int main() {
     Trie trie;
     trie.insert("apple");
@@ -88,5 +438,17 @@ int main() {
     std::cout << "Starts with 'ba': " << (trie.startsWith("ba") ? "Yes" : "No") << "\n";
     std::cout << "Starts with 'cat': " << (trie.startsWith("cat") ? "Yes" : "No") << "\n";
 
+    std::cout << "\n--- Compact Trie (autocomplete) ---\n";
+    CompactTrie queries({{"how to cook rice", 900}, {"how to tie a tie", 750}, {"how tall is everest", 400},
+                         {"how to code in c++", 620}, {"hotel deals", 300}, {"h\xc3\xa9llo", 50}});
+    std::cout << "Top 3 for 'how t':\n";
+    for (const auto& [word, score] : queries.topK("how t", 3))
+        std::cout << "- " << word << " (" << score << ")\n";
+    std::cout << "Search 'how to code in c++': "
+              << (queries.search("how to code in c++") ? "Found" : "Not Found") << "\n";
+
+    std::cout << "\n--- Benchmark ---\n";
+    benchmark(300000);
+
     return 0;
 }
@@ -2,66 +2,535 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <memory>
+#include <cstring>
+#include <cstdio>
+#include <stdexcept>
+#include <limits>
+#include <thread>
+#include <atomic>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
+// SA-IS (Nong, Zhang & Chan): linear-time suffix sorting by induced sorting.
+// Works on any integer alphabet [0, upper]; Index is int32_t for texts under
+// 2 GiB and int64_t for anything larger.
+template <typename Index, typename Symbol>
+std::vector<Index> saIs(const Symbol* s, Index n, Index upper) {
+    if (n == 0) return {};
+    if (n == 1) return {0};
+    if (n == 2) return s[0] < s[1] ? std::vector<Index>{0, 1} : std::vector<Index>{1, 0};
+
+    std::vector<Index> sa(n);
+    std::vector<bool> isS(n); // true = S-type suffix, false = L-type
+    for (Index i = n - 2; i >= 0; --i)
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+
+    // Bucket boundaries: sumL[c] = start of bucket c, sumS[c] = start of its S part
+    std::vector<Index> sumL(upper + 2, 0), sumS(upper + 2, 0);
+    for (Index i = 0; i < n; ++i) {
+        if (!isS[i]) sumS[s[i]]++;
+        else         sumL[s[i] + 1]++;
+    }
+    for (Index c = 0; c <= upper; ++c) {
+        sumS[c] += sumL[c];
+        sumL[c + 1] += sumS[c];
+    }
+
+    std::vector<Index> buf(upper + 2);
+    auto induce = [&](const std::vector<Index>& lms) {
+        std::fill(sa.begin(), sa.end(), Index(-1));
+        std::copy(sumS.begin(), sumS.end(), buf.begin());
+        for (Index d : lms)
+            if (d != n) sa[buf[s[d]]++] = d;
+
+        // L-type suffixes, left to right
+        std::copy(sumL.begin(), sumL.end(), buf.begin());
+        sa[buf[s[n - 1]]++] = n - 1;
+        for (Index i = 0; i < n; ++i) {
+            Index v = sa[i];
+            if (v >= 1 && !isS[v - 1]) sa[buf[s[v - 1]]++] = v - 1;
+        }
+
+        // S-type suffixes, right to left
+        std::copy(sumL.begin(), sumL.end(), buf.begin());
+        for (Index i = n - 1; i >= 0; --i) {
+            Index v = sa[i];
+            if (v >= 1 && isS[v - 1]) sa[--buf[s[v - 1] + 1]] = v - 1;
+        }
+    };
+
+    std::vector<Index> lmsMap(n + 1, -1);
+    std::vector<Index> lms;
+    for (Index i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsMap[i] = Index(lms.size());
+            lms.push_back(i);
+        }
+    }
+    Index m = Index(lms.size());
+
+    induce(lms);
+    if (m == 0) return sa;
+
+    // Name LMS substrings in sorted order, then recurse on the reduced string
+    std::vector<Index> sortedLms;
+    sortedLms.reserve(m);
+    for (Index v : sa)
+        if (lmsMap[v] != -1) sortedLms.push_back(v);
+
+    std::vector<Index> reduced(m);
+    Index recUpper = 0;
+    reduced[lmsMap[sortedLms[0]]] = 0;
+    for (Index i = 1; i < m; ++i) {
+        Index l = sortedLms[i - 1], r = sortedLms[i];
+        Index endL = (lmsMap[l] + 1 < m) ? lms[lmsMap[l] + 1] : n;
+        Index endR = (lmsMap[r] + 1 < m) ? lms[lmsMap[r] + 1] : n;
+        bool same = true;
+        if (endL - l != endR - r) {
+            same = false;
+        } else {
+            while (l < endL && s[l] == s[r]) { ++l; ++r; }
+            if (l == n || s[l] != s[r]) same = false;
+        }
+        if (!same) ++recUpper;
+        reduced[lmsMap[sortedLms[i]]] = recUpper;
+    }
+    std::vector<Index>().swap(lmsMap);
+
+    std::vector<Index> recSa = saIs<Index>(reduced.data(), m, recUpper);
+    for (Index i = 0; i < m; ++i)
+        sortedLms[i] = lms[recSa[i]];
+    induce(sortedLms);
+    return sa;
+}
+
+// ---------- On-disk index format ----------
+// Every section is 8-byte aligned so arrays can be used in place from a
+// read-only mapping; the OS page cache shares those pages between processes.
+
+class MappedFile {
+private:
+    const char* base = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open " + path);
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) throw std::runtime_error("Cannot stat " + path);
+        length = size_t(size.QuadPart);
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) throw std::runtime_error("Cannot map " + path);
+        base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!base) throw std::runtime_error("Cannot map " + path);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        length = size_t(st.st_size);
+        void* p = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) throw std::runtime_error("Cannot map " + path);
+        base = static_cast<const char*>(p);
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (base) UnmapViewOfFile(base);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (base) munmap(const_cast<char*>(base), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+};
+
+// Read-only array that either owns its elements or views them inside a
+// MappedFile; the index classes use it for everything they serialize.
+template <typename T>
+class MappedArray {
+private:
+    std::vector<T> owned;
+    const T* ptr = nullptr;
+    size_t len = 0;
+
+public:
+    MappedArray() = default;
+    MappedArray(std::vector<T> v) : owned(std::move(v)), ptr(owned.data()), len(owned.size()) {}
+    MappedArray(const MappedArray& o) : owned(o.owned), ptr(o.isOwned() ? owned.data() : o.ptr), len(o.len) {}
+    MappedArray(MappedArray&&) = default;
+    MappedArray& operator=(MappedArray o) {
+        bool ownedBuffer = o.isOwned();
+        owned = std::move(o.owned);
+        ptr = ownedBuffer ? owned.data() : o.ptr;
+        len = o.len;
+        return *this;
+    }
+
+    static MappedArray view(const T* p, size_t n) {
+        MappedArray a;
+        a.ptr = p;
+        a.len = n;
+        return a;
+    }
+
+    bool isOwned() const { return !owned.empty() && ptr == owned.data(); }
+    const T& operator[](size_t i) const { return ptr[i]; }
+    const T* data() const { return ptr; }
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + len; }
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+};
+
+const uint32_t INDEX_BYTE_ORDER = 0x01020304; // catches files written on the other endianness
+
+class IndexWriter {
+private:
+    std::ofstream out;
+    size_t offset = 0;
+
+    void pad() {
+        static const char zeros[8] = {};
+        if (offset % 8) {
+            out.write(zeros, 8 - offset % 8);
+            offset += 8 - offset % 8;
+        }
+    }
+
+public:
+    explicit IndexWriter(const std::string& path) : out(path, std::ios::binary | std::ios::trunc) {
+        if (!out) throw std::runtime_error("Cannot write " + path);
+    }
+
+    template <typename T>
+    void pod(const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        offset += sizeof(T);
+        pad();
+    }
+
+    template <typename T>
+    void array(const T* values, size_t n) {
+        pod(uint64_t(n));
+        out.write(reinterpret_cast<const char*>(values), std::streamsize(n * sizeof(T)));
+        offset += n * sizeof(T);
+        pad();
+    }
+
+    template <typename Container>
+    void array(const Container& c) { array(c.data(), c.size()); }
+};
+
+class IndexReader {
+private:
+    const MappedFile& file;
+    size_t offset = 0;
+
+    // offset may pass the end by the padding of the last array
+    const char* take(size_t bytes) {
+        if (offset > file.size() || bytes > file.size() - offset) throw std::runtime_error("Truncated index file");
+        const char* p = file.data() + offset;
+        offset += (bytes + 7) / 8 * 8;
+        return p;
+    }
+
+public:
+    explicit IndexReader(const MappedFile& f) : file(f) {}
+
+    template <typename T>
+    T pod() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    MappedArray<T> array() {
+        uint64_t n = pod<uint64_t>();
+        // Compare counts rather than bytes so a corrupt n cannot overflow n * sizeof(T)
+        if (offset > file.size() || n > (file.size() - offset) / sizeof(T))
+            throw std::runtime_error("Truncated index file");
+        return MappedArray<T>::view(reinterpret_cast<const T*>(take(size_t(n) * sizeof(T))), size_t(n));
+    }
+};
+
+// ---------- Suffix Array ----------
+
+// Index = int32_t handles texts up to 2 GiB; use SuffixArray<int64_t> beyond that.
+template <typename Index = int32_t>
 class SuffixArray {
 private:
-    std::string text;
-    std::vector<int> sa;   // Suffix array
-    std::vector<int> lcp;  // Longest Common Prefix array
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+    // File layout: header, then text, sa, lcp and searchLcp as length-prefixed arrays
+    struct FileHeader {
+        char magic[8];        // "SUFARRAY"
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t indexBytes;  // sizeof(Index)
+        uint32_t reserved;
+    };
+
+    MappedArray<char> text;
+    MappedArray<Index> sa;   // Suffix array
+    MappedArray<Index> lcp;  // Longest Common Prefix array
+    MappedArray<Index> searchLcp; // per search midpoint: {LCP with left bound, LCP with right bound}
+    std::shared_ptr<MappedFile> mapping; // set when loaded from disk
+
+    SuffixArray() = default;
+
+    std::string_view view() const { return {text.data(), text.size()}; }
+
+    // Returns LCP(sa[L], sa[R]); out-of-range bounds count as LCP 0
+    Index fillSearchLCP(Index L, Index R, std::vector<Index>& out) const {
+        Index n = Index(text.size());
+        if (R - L == 1) return (L < 0 || R >= n) ? 0 : lcp[R];
+        Index M = L + (R - L) / 2;
+        out[2 * M] = fillSearchLCP(L, M, out);
+        out[2 * M + 1] = fillSearchLCP(M, R, out);
+        return std::min(out[2 * M], out[2 * M + 1]);
+    }
+
+    // Length of the common prefix of suffix pos and pattern, given that the
+    // first k characters already match; skips ahead 8 bytes at a time.
+    size_t extendMatch(size_t pos, const std::string& pattern, size_t k) const {
+        size_t limit = std::min(pattern.size(), text.size() - pos);
+        const char* t = text.data() + pos;
+        while (k + 8 <= limit) {
+            uint64_t x, y;
+            std::memcpy(&x, t + k, 8);
+            std::memcpy(&y, pattern.data() + k, 8);
+            if (x != y) break; // the byte loop below finds the exact mismatch
+            k += 8;
+        }
+        while (k < limit && t[k] == pattern[k]) ++k;
+        return k;
+    }
+
+    template <typename Fn>
+    static void forEachSorted(const std::vector<std::string>& patterns, unsigned threads, Fn&& answer) {
+        // Group by the first 8 bytes only; comparing whole patterns costs more
+        // than it saves when they share long prefixes
+        std::vector<std::pair<uint64_t, size_t>> keyed(patterns.size());
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            uint64_t key = 0;
+            for (size_t j = 0; j < 8; ++j)
+                key = key << 8 | (j < patterns[i].size() ? (unsigned char)patterns[i][j] : 0);
+            keyed[i] = {key, i};
+        }
+        std::sort(keyed.begin(), keyed.end());
+        std::vector<size_t> order(patterns.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = keyed[i].second;
+
+        const size_t chunk = 256;
+        std::atomic<size_t> next{0};
+        auto worker = [&] {
+            for (size_t begin; (begin = next.fetch_add(chunk)) < order.size();) {
+                size_t end = std::min(order.size(), begin + chunk);
+                for (size_t i = begin; i < end; ++i) answer(order[i]);
+            }
+        };
+
+        size_t chunks = (order.size() + chunk - 1) / chunk;
+        threads = unsigned(std::max<size_t>(1, std::min<size_t>(threads, chunks)));
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+        worker();
+        for (auto& th : pool) th.join();
+    }
+
+    // First row whose suffix is >= pattern (upper = false) or > pattern
+    // (upper = true), comparing only the first m characters. l and r are
+    // the matched lengths against the current bounds; searchLcp lets each
+    // step skip characters already known to match.
+    Index boundary(const std::string& pattern, bool upper) const {
+        Index n = Index(text.size());
+        size_t m = pattern.size();
+        Index L = -1, R = n;
+        size_t l = 0, r = 0;
+
+        while (R - L > 1) {
+            Index M = L + (R - L) / 2;
+            size_t k;
+            if (l >= r) {
+                size_t known = size_t(searchLcp[2 * M]);
+                if (known > l) { L = M; continue; }
+                if (known < l) { R = M; r = known; continue; }
+                k = l;
+            } else {
+                size_t known = size_t(searchLcp[2 * M + 1]);
+                if (known > r) { R = M; continue; }
+                if (known < r) { L = M; l = known; continue; }
+                k = r;
+            }
+
+            size_t pos = size_t(sa[M]);
+            k = extendMatch(pos, pattern, k);
+
+            bool goLeft;
+            if (k == m) goLeft = !upper;                 // pattern is a prefix of this suffix
+            else if (pos + k == size_t(n)) goLeft = false; // suffix is a proper prefix of pattern
+            else goLeft = (unsigned char)text[pos + k] > (unsigned char)pattern[k];
+
+            if (goLeft) { R = M; r = k; }
+            else        { L = M; l = k; }
+        }
+        return R;
+    }
+
+    // Rejects texts whose length does not fit in Index, before the copy
+    static const std::string& checkLength(const std::string& s) {
+        if (s.size() > size_t(std::numeric_limits<Index>::max()))
+            throw std::length_error("Text of " + std::to_string(s.size()) + " bytes is too long for a " +
+                                    std::to_string(8 * sizeof(Index)) + "-bit SuffixArray; use SuffixArray<int64_t>");
+        return s;
+    }
 
 public:
-    SuffixArray(const std::string& s) : text(s) {
+    SuffixArray(const std::string& s) : text(std::vector<char>(checkLength(s).begin(), s.end())) {
         buildSuffixArray();
         buildLCP();
+        buildSearchLCP();
+    }
+
+    void save(const std::string& path) const {
+        FileHeader h{{'S', 'U', 'F', 'A', 'R', 'R', 'A', 'Y'}, FORMAT_VERSION, INDEX_BYTE_ORDER,
+                     uint32_t(sizeof(Index)), 0};
+        IndexWriter out(path);
+        out.pod(h);
+        out.array(text);
+        out.array(sa);
+        out.array(lcp);
+        out.array(searchLcp);
     }
 
+    // Zero-copy open: the arrays point straight into the read-only mapping.
+    // Only the header and array sizes are checked, in O(1); call verify()
+    // before searching a file that may be corrupt or untrusted.
+    static SuffixArray load(const std::string& path) {
+        auto file = std::make_shared<MappedFile>(path);
+        IndexReader in(*file);
+        FileHeader h = in.pod<FileHeader>();
+        if (std::memcmp(h.magic, "SUFARRAY", 8) != 0)
+            throw std::runtime_error(path + " is not a suffix array index");
+        if (h.version != FORMAT_VERSION || h.byteOrder != INDEX_BYTE_ORDER || h.indexBytes != sizeof(Index))
+            throw std::runtime_error(path + ": unsupported version, byte order or index width");
+
+        SuffixArray result;
+        result.text = in.array<char>();
+        result.sa = in.array<Index>();
+        result.lcp = in.array<Index>();
+        result.searchLcp = in.array<Index>();
+
+        size_t n = result.text.size();
+        if (n > size_t(std::numeric_limits<Index>::max()) || result.sa.size() != n || result.lcp.size() != n ||
+            result.searchLcp.size() != 2 * n)
+            throw std::runtime_error(path + ": corrupt index (array sizes)");
+        result.mapping = std::move(file);
+        return result;
+    }
+
+    // Search indexes text through sa and skips ahead by the stored LCPs, so
+    // every entry must stay inside the text. One O(n) pass that touches the
+    // whole mapping, which is why load() leaves it to the caller.
+    void verify() const {
+        size_t n = text.size();
+        for (Index p : sa)
+            if (p < 0 || size_t(p) >= n) throw std::runtime_error("corrupt index (suffix array)");
+        for (const MappedArray<Index>* heights : {&lcp, &searchLcp})
+            for (Index h : *heights)
+                if (h < 0 || size_t(h) > n) throw std::runtime_error("corrupt index (LCP array)");
+    }
+
+    // Linear time and memory via SA-IS. Bytes are ranked as unsigned char,
+    // the same order std::string::compare uses when searching.
     void buildSuffixArray() {
-        int n = text.size();
-        sa.resize(n);
-        for (int i = 0; i < n; ++i) sa[i] = i;
-
-        // Optimized comparator: avoid substr
-        std::sort(sa.begin(), sa.end(), [&](int a, int b) {
-            while (a < n && b < n) {
-                if (text[a] != text[b]) return text[a] < text[b];
-                ++a; ++b;
-            }
-            return a == n;
-        });
+        Index n = Index(text.size());
+        sa = saIs<Index>(reinterpret_cast<const unsigned char*>(text.data()), n, Index(255));
     }
 
+    // Kasai et al. - O(n)
     void buildLCP() {
-        int n = text.size();
-        lcp.resize(n, 0);
-        std::vector<int> rank(n, 0);
+        Index n = Index(text.size());
+        std::vector<Index> heights(n, 0);
+        std::vector<Index> rank(n, 0);
 
-        for (int i = 0; i < n; ++i)
+        for (Index i = 0; i < n; ++i)
             rank[sa[i]] = i;
 
-        int h = 0;
-        for (int i = 0; i < n; ++i) {
+        Index h = 0;
+        for (Index i = 0; i < n; ++i) {
             if (rank[i] > 0) {
-                int j = sa[rank[i] - 1];
+                Index j = sa[rank[i] - 1];
                 while (i + h < n && j + h < n && text[i + h] == text[j + h])
                     ++h;
-                lcp[rank[i]] = h;
+                heights[rank[i]] = h;
                 if (h > 0) --h;
             }
         }
+        lcp = std::move(heights);
+    }
+
+    // Manber-Myers: for every midpoint M of the binary search over (L, R),
+    // store LCP(sa[L], sa[M]) and LCP(sa[M], sa[R]) side by side so one
+    // cache line serves both.
+    void buildSearchLCP() {
+        Index n = Index(text.size());
+        std::vector<Index> out(2 * size_t(n), 0);
+        fillSearchLCP(-1, n, out);
+        searchLcp = std::move(out);
+    }
+
+    // Row range [lo, hi) of suffixes starting with pattern, O(m + log n)
+    std::pair<Index, Index> range(const std::string& pattern) const {
+        return {boundary(pattern, false), boundary(pattern, true)};
     }
 
-    std::vector<int> searchAll(const std::string& pattern) {
-        std::vector<int> result;
-        int n = text.size();
-        int m = pattern.size();
+    // Plain binary search comparing the whole pattern at every step, O(m log n)
+    std::pair<Index, Index> plainRange(const std::string& pattern) const {
+        std::string_view t = view();
+        Index n = Index(text.size());
+        size_t m = pattern.size();
 
-        int left = 0, right = n - 1;
-        int start = -1, end = -1;
+        Index left = 0, right = n - 1;
+        Index start = -1, end = -1;
 
         // Find lower bound
         while (left <= right) {
-            int mid = (left + right) / 2;
-            int cmp = text.compare(sa[mid], m, pattern);
+            Index mid = left + (right - left) / 2;
+            int cmp = t.compare(sa[mid], m, pattern);
             if (cmp >= 0) {
                 right = mid - 1;
                 if (cmp == 0) start = mid;
@@ -74,8 +543,8 @@ public:
 
         // Find upper bound
         while (left <= right) {
-            int mid = (left + right) / 2;
-            int cmp = text.compare(sa[mid], m, pattern);
+            Index mid = left + (right - left) / 2;
+            int cmp = t.compare(sa[mid], m, pattern);
             if (cmp <= 0) {
                 left = mid + 1;
                 if (cmp == 0) end = mid;
@@ -84,30 +553,121 @@ public:
             }
         }
 
-        if (start != -1 && end != -1) {
-            for (int i = start; i <= end; ++i)
-                result.push_back(sa[i]);
-        }
+        if (start == -1 || end == -1) return {0, 0};
+        return {start, end + 1};
+    }
 
+    std::vector<Index> searchAll(const std::string& pattern) const {
+        auto [lo, hi] = range(pattern);
+        std::vector<Index> result(sa.begin() + lo, sa.begin() + hi);
         std::sort(result.begin(), result.end()); // Optional: to return in original order
         return result;
     }
 
-    void printSuffixArray() {
+    // Batch versions of range() and searchAll(). Queries run grouped by
+    // prefix so that neighbours revisit the same SA rows while they are
+    // still cached; chunks of that order go to worker threads.
+    std::vector<std::pair<Index, Index>> rangeBatch(const std::vector<std::string>& patterns,
+                                                    unsigned threads = std::thread::hardware_concurrency()) const {
+        std::vector<std::pair<Index, Index>> results(patterns.size());
+        forEachSorted(patterns, threads, [&](size_t i) { results[i] = range(patterns[i]); });
+        return results;
+    }
+
+    std::vector<std::vector<Index>> searchBatch(const std::vector<std::string>& patterns,
+                                                unsigned threads = std::thread::hardware_concurrency()) const {
+        std::vector<std::vector<Index>> results(patterns.size());
+        forEachSorted(patterns, threads, [&](size_t i) { results[i] = searchAll(patterns[i]); });
+        return results;
+    }
+
+    void printSuffixArray() const {
         std::cout << "\nSuffix Array:\n";
-        for (int i : sa)
-            std::cout << i << ": " << text.substr(i) << "\n";
+        for (Index i : sa)
+            std::cout << i << ": " << view().substr(i) << "\n";
     }
 
-    void printLCP() {
+    void printLCP() const {
         std::cout << "\nLCP Array:\n";
-        for (int i = 1; i < lcp.size(); ++i)
-            std::cout << "LCP between '" << text.substr(sa[i - 1]) << "' and '" << text.substr(sa[i])
+        for (size_t i = 1; i < lcp.size(); ++i)
+            std::cout << "LCP between '" << view().substr(sa[i - 1]) << "' and '" << view().substr(sa[i])
                       << "' is " << lcp[i] << "\n";
     }
 };
 
-int main() {
+// ---------- Benchmark: SA-IS vs. the old comparator sort ----------
+
+// The previous builder: O(n^2 log n) on repetitive input.
+std::vector<int32_t> comparatorSort(const std::string& text) {
+    int32_t n = int32_t(text.size());
+    std::vector<int32_t> sa(n);
+    for (int32_t i = 0; i < n; ++i) sa[i] = i;
+    std::sort(sa.begin(), sa.end(), [&](int32_t a, int32_t b) {
+        while (a < n && b < n) {
+            if (text[a] != text[b]) return (unsigned char)text[a] < (unsigned char)text[b];
+            ++a; ++b;
+        }
+        return a == n;
+    });
+    return sa;
+}
+
+template <typename F>
+double timeMs(F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void benchmark(const std::string& name, const std::string& text) {
+    std::vector<int32_t> sais, naive;
+    std::vector<int64_t> sais64;
+    auto n = int64_t(text.size());
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+
+    double tSais = timeMs([&] { sais = saIs<int32_t>(bytes, int32_t(n), 255); });
+    double tSais64 = timeMs([&] { sais64 = saIs<int64_t>(bytes, n, 255); });
+    double tNaive = timeMs([&] { naive = comparatorSort(text); });
+
+    bool same = sais == naive && std::equal(sais.begin(), sais.end(), sais64.begin());
+    std::cout << "  " << name << " (n=" << n << ")\n"
+              << "    comparator sort: " << tNaive << " ms\n"
+              << "    SA-IS int32:     " << tSais << " ms\n"
+              << "    SA-IS int64:     " << tSais64 << " ms\n"
+              << "    results match:   " << (same ? "yes" : "NO") << "\n";
+}
+
+void searchBenchmark(const std::string& name, const std::string& text, size_t minLen, size_t maxLen,
+                     std::mt19937& rng) {
+    SuffixArray<int32_t> index(text);
+    std::vector<std::string> queries;
+    for (int q = 0; q < 100000; ++q) {
+        size_t len = minLen + rng() % (maxLen - minLen + 1);
+        queries.push_back(text.substr(rng() % (text.size() - len), len));
+    }
+
+    size_t plainHits = 0, lcpHits = 0, batchHits = 0;
+    double tPlain = timeMs([&] {
+        for (const auto& q : queries) { auto [lo, hi] = index.plainRange(q); plainHits += hi - lo; }
+    });
+    double tLcp = timeMs([&] {
+        for (const auto& q : queries) { auto [lo, hi] = index.range(q); lcpHits += hi - lo; }
+    });
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    double tBatch = timeMs([&] {
+        for (auto [lo, hi] : index.rangeBatch(queries, threads)) batchHits += hi - lo;
+    });
+
+    auto qps = [&](double ms) { return double(queries.size()) / (ms / 1000.0); };
+    std::cout << "  " << name << " (n=" << text.size() << ", " << queries.size() << " queries)\n"
+              << "    plain binary search:     " << qps(tPlain) << " queries/s\n"
+              << "    LCP-accelerated:         " << qps(tLcp) << " queries/s\n"
+              << "    batch, " << threads << " thread(s):      " << qps(tBatch) << " queries/s\n"
+              << "    hit counts agree:        "
+              << (plainHits == lcpHits && lcpHits == batchHits ? "yes" : "NO") << "\n";
+}
+
+int main(int argc, char** argv) {
     std::string text = "banana";
     SuffixArray sa(text);
 
@@ -126,5 +686,72 @@ int main() {
     }
     std::cout << "\n";
 
+    // 64-bit index mode for corpora larger than 2 GiB
+    SuffixArray<int64_t> sa64(text);
+    std::cout << "64-bit index mode gives the same positions: "
+              << (sa64.searchAll(pattern).size() == positions.size() ? "yes" : "no") << "\n";
+
+    // Optional: pass a file path to benchmark on real text
+    std::cout << "\n--- Construction Benchmark ---\n";
+    std::mt19937 rng(42);
+
+    std::string randomText(1 << 20, ' ');
+    for (char& c : randomText) c = char('a' + rng() % 26);
+    benchmark("random a-z", randomText);
+
+    // Periodic input is the comparator's worst case, so keep it small
+    std::string periodic;
+    while (periodic.size() < 20000) periodic += "abracadabra";
+    benchmark("periodic", periodic);
+
+    std::string realText;
+    if (argc > 1) {
+        std::ifstream in(argv[1], std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        realText = ss.str();
+    } else {
+        // Stand-in for log files: templated lines with few distinct values
+        const char* levels[] = {"INFO", "WARN", "ERROR"};
+        const char* events[] = {"request served", "cache miss", "connection reset", "retrying upstream"};
+        while (realText.size() < (1 << 19)) {
+            realText += "2024-05-01 12:00:" + std::to_string(rng() % 60) + " " + levels[rng() % 3] +
+                        " worker-" + std::to_string(rng() % 8) + ": " + events[rng() % 4] + "\n";
+        }
+    }
+    benchmark(argc > 1 ? argv[1] : "log-like text", realText);
+
+    // Query throughput; long patterns over repetitive text are where the
+    // plain search re-compares the most characters per step
+    std::cout << "\n--- Search Throughput ---\n";
+    searchBenchmark("log-like text, 8-40 chars", realText, 8, 40, rng);
+    std::string repetitive;
+    while (repetitive.size() < (1 << 20)) repetitive += "GATTACA";
+    for (size_t i = 0; i < repetitive.size(); i += 4096) repetitive[rng() % repetitive.size()] = 'N';
+    searchBenchmark("repetitive DNA, 200-1000 chars", repetitive, 200, 1000, rng);
+
+    // Build once, then reopen the saved index instead of rebuilding
+    std::cout << "\n--- On-disk Index ---\n";
+    const std::string indexPath = "suffix_array.idx";
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        SuffixArray<int32_t> built(randomText);
+        auto t1 = std::chrono::steady_clock::now();
+        built.save(indexPath);
+        auto t2 = std::chrono::steady_clock::now();
+        SuffixArray<int32_t> loaded = SuffixArray<int32_t>::load(indexPath);
+        auto t3 = std::chrono::steady_clock::now();
+        loaded.verify();
+        auto t4 = std::chrono::steady_clock::now();
+        auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+        std::string probe = randomText.substr(12345, 6);
+        std::cout << "  build: " << ms(t0, t1) << " ms, save: " << ms(t1, t2) << " ms, mmap load: " << ms(t2, t3)
+                  << " ms, full verify: " << ms(t3, t4) << " ms\n"
+                  << "  loaded index finds '" << probe << "' at the same positions: "
+                  << (loaded.searchAll(probe) == built.searchAll(probe) ? "yes" : "NO") << "\n";
+    } // unmap before deleting the file
+    std::remove(indexPath.c_str());
+
     return 0;
 }
@@ -3,76 +3,681 @@
 #include <vector>
 #include <algorithm>
 #include <iomanip>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <memory>
+#include <cstring>
+#include <cstdio>
+#include <stdexcept>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
+// SA-IS (Nong, Zhang & Chan): linear-time suffix sorting by induced sorting.
+// Same builder as 04-suffix_array.cpp.
+template <typename Index, typename Symbol>
+std::vector<Index> saIs(const Symbol* s, Index n, Index upper) {
+    if (n == 0) return {};
+    if (n == 1) return {0};
+    if (n == 2) return s[0] < s[1] ? std::vector<Index>{0, 1} : std::vector<Index>{1, 0};
+
+    std::vector<Index> sa(n);
+    std::vector<bool> isS(n); // true = S-type suffix, false = L-type
+    for (Index i = n - 2; i >= 0; --i)
+        isS[i] = (s[i] == s[i + 1]) ? isS[i + 1] : (s[i] < s[i + 1]);
+
+    std::vector<Index> sumL(upper + 2, 0), sumS(upper + 2, 0);
+    for (Index i = 0; i < n; ++i) {
+        if (!isS[i]) sumS[s[i]]++;
+        else         sumL[s[i] + 1]++;
+    }
+    for (Index c = 0; c <= upper; ++c) {
+        sumS[c] += sumL[c];
+        sumL[c + 1] += sumS[c];
+    }
+
+    std::vector<Index> buf(upper + 2);
+    auto induce = [&](const std::vector<Index>& lms) {
+        std::fill(sa.begin(), sa.end(), Index(-1));
+        std::copy(sumS.begin(), sumS.end(), buf.begin());
+        for (Index d : lms)
+            if (d != n) sa[buf[s[d]]++] = d;
+
+        std::copy(sumL.begin(), sumL.end(), buf.begin());
+        sa[buf[s[n - 1]]++] = n - 1;
+        for (Index i = 0; i < n; ++i) {
+            Index v = sa[i];
+            if (v >= 1 && !isS[v - 1]) sa[buf[s[v - 1]]++] = v - 1;
+        }
+
+        std::copy(sumL.begin(), sumL.end(), buf.begin());
+        for (Index i = n - 1; i >= 0; --i) {
+            Index v = sa[i];
+            if (v >= 1 && isS[v - 1]) sa[--buf[s[v - 1] + 1]] = v - 1;
+        }
+    };
+
+    std::vector<Index> lmsMap(n + 1, -1);
+    std::vector<Index> lms;
+    for (Index i = 1; i < n; ++i) {
+        if (!isS[i - 1] && isS[i]) {
+            lmsMap[i] = Index(lms.size());
+            lms.push_back(i);
+        }
+    }
+    Index m = Index(lms.size());
+
+    induce(lms);
+    if (m == 0) return sa;
+
+    std::vector<Index> sortedLms;
+    sortedLms.reserve(m);
+    for (Index v : sa)
+        if (lmsMap[v] != -1) sortedLms.push_back(v);
+
+    std::vector<Index> reduced(m);
+    Index recUpper = 0;
+    reduced[lmsMap[sortedLms[0]]] = 0;
+    for (Index i = 1; i < m; ++i) {
+        Index l = sortedLms[i - 1], r = sortedLms[i];
+        Index endL = (lmsMap[l] + 1 < m) ? lms[lmsMap[l] + 1] : n;
+        Index endR = (lmsMap[r] + 1 < m) ? lms[lmsMap[r] + 1] : n;
+        bool same = true;
+        if (endL - l != endR - r) {
+            same = false;
+        } else {
+            while (l < endL && s[l] == s[r]) { ++l; ++r; }
+            if (l == n || s[l] != s[r]) same = false;
+        }
+        if (!same) ++recUpper;
+        reduced[lmsMap[sortedLms[i]]] = recUpper;
+    }
+    std::vector<Index>().swap(lmsMap);
+
+    std::vector<Index> recSa = saIs<Index>(reduced.data(), m, recUpper);
+    for (Index i = 0; i < m; ++i)
+        sortedLms[i] = lms[recSa[i]];
+    induce(sortedLms);
+    return sa;
+}
+
+// ---------- On-disk index format ----------
+// Every section is 8-byte aligned so arrays can be used in place from a
+// read-only mapping; the OS page cache shares those pages between processes.
+
+class MappedFile {
+private:
+    const char* base = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open " + path);
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) throw std::runtime_error("Cannot stat " + path);
+        length = size_t(size.QuadPart);
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) throw std::runtime_error("Cannot map " + path);
+        base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!base) throw std::runtime_error("Cannot map " + path);
+#else
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        length = size_t(st.st_size);
+        void* p = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) throw std::runtime_error("Cannot map " + path);
+        base = static_cast<const char*>(p);
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (base) UnmapViewOfFile(base);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (base) munmap(const_cast<char*>(base), length);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+};
+
+// Read-only array that either owns its elements or views them inside a
+// MappedFile; the index classes use it for everything they serialize.
+template <typename T>
+class MappedArray {
+private:
+    std::vector<T> owned;
+    const T* ptr = nullptr;
+    size_t len = 0;
+
+public:
+    MappedArray() = default;
+    MappedArray(std::vector<T> v) : owned(std::move(v)), ptr(owned.data()), len(owned.size()) {}
+    MappedArray(const MappedArray& o) : owned(o.owned), ptr(o.isOwned() ? owned.data() : o.ptr), len(o.len) {}
+    MappedArray(MappedArray&&) = default;
+    MappedArray& operator=(MappedArray o) {
+        bool ownedBuffer = o.isOwned();
+        owned = std::move(o.owned);
+        ptr = ownedBuffer ? owned.data() : o.ptr;
+        len = o.len;
+        return *this;
+    }
+
+    static MappedArray view(const T* p, size_t n) {
+        MappedArray a;
+        a.ptr = p;
+        a.len = n;
+        return a;
+    }
+
+    bool isOwned() const { return !owned.empty() && ptr == owned.data(); }
+    const T& operator[](size_t i) const { return ptr[i]; }
+    const T* data() const { return ptr; }
+    const T* begin() const { return ptr; }
+    const T* end() const { return ptr + len; }
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+};
+
+const uint32_t INDEX_BYTE_ORDER = 0x01020304; // catches files written on the other endianness
+
+class IndexWriter {
+private:
+    std::ofstream out;
+    size_t offset = 0;
+
+    void pad() {
+        static const char zeros[8] = {};
+        if (offset % 8) {
+            out.write(zeros, 8 - offset % 8);
+            offset += 8 - offset % 8;
+        }
+    }
+
+public:
+    explicit IndexWriter(const std::string& path) : out(path, std::ios::binary | std::ios::trunc) {
+        if (!out) throw std::runtime_error("Cannot write " + path);
+    }
+
+    template <typename T>
+    void pod(const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        offset += sizeof(T);
+        pad();
+    }
+
+    template <typename T>
+    void array(const T* values, size_t n) {
+        pod(uint64_t(n));
+        out.write(reinterpret_cast<const char*>(values), std::streamsize(n * sizeof(T)));
+        offset += n * sizeof(T);
+        pad();
+    }
+
+    template <typename Container>
+    void array(const Container& c) { array(c.data(), c.size()); }
+};
+
+class IndexReader {
+private:
+    const MappedFile& file;
+    size_t offset = 0;
+
+    // offset may pass the end by the padding of the last array
+    const char* take(size_t bytes) {
+        if (offset > file.size() || bytes > file.size() - offset) throw std::runtime_error("Truncated index file");
+        const char* p = file.data() + offset;
+        offset += (bytes + 7) / 8 * 8;
+        return p;
+    }
+
+public:
+    explicit IndexReader(const MappedFile& f) : file(f) {}
+
+    template <typename T>
+    T pod() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    MappedArray<T> array() {
+        uint64_t n = pod<uint64_t>();
+        // Compare counts rather than bytes so a corrupt n cannot overflow n * sizeof(T)
+        if (offset > file.size() || n > (file.size() - offset) / sizeof(T))
+            throw std::runtime_error("Truncated index file");
+        return MappedArray<T>::view(reinterpret_cast<const T*>(take(size_t(n) * sizeof(T))), size_t(n));
+    }
+};
+
+// ---------- FM-Index ----------
+
+// Plain bitvector with a rank directory: one cumulative count per 512-bit
+// block (12.5% overhead), the rest is answered with popcount.
+class RankBitVector {
+private:
+    MappedArray<uint64_t> words;
+    MappedArray<uint64_t> blockRank; // ones before each 512-bit block
+    size_t length = 0;
+
+public:
+    RankBitVector() = default;
+
+    // bits holds (n + 63) / 64 words, bit i at words[i / 64] >> (i % 64)
+    RankBitVector(std::vector<uint64_t> bits, size_t n) : length(n) {
+        std::vector<uint64_t> ranks(bits.size() / 8 + 1, 0);
+        uint64_t ones = 0;
+        for (size_t w = 0; w < bits.size(); ++w) {
+            if (w % 8 == 0) ranks[w / 8] = ones;
+            ones += __builtin_popcountll(bits[w]);
+        }
+        if (bits.size() % 8 == 0) ranks[bits.size() / 8] = ones;
+        words = std::move(bits);
+        blockRank = std::move(ranks);
+    }
+
+    static void set(std::vector<uint64_t>& bits, size_t i) { bits[i / 64] |= uint64_t(1) << (i % 64); }
+
+    bool get(size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+    size_t size() const { return length; }
+
+    // Number of set bits in [0, i)
+    size_t rank1(size_t i) const {
+        size_t w = i / 64;
+        size_t r = blockRank[w / 8];
+        for (size_t k = (w / 8) * 8; k < w; ++k)
+            r += __builtin_popcountll(words[k]);
+        if (i % 64) r += __builtin_popcountll(words[w] & ((uint64_t(1) << (i % 64)) - 1));
+        return r;
+    }
+
+    size_t rank0(size_t i) const { return i - rank1(i); }
+
+    size_t bytes() const { return (words.size() + blockRank.size()) * sizeof(uint64_t); }
+
+    void save(IndexWriter& out) const {
+        out.pod(uint64_t(length));
+        out.array(words);
+        out.array(blockRank);
+    }
+
+    static RankBitVector load(IndexReader& in) {
+        RankBitVector bv;
+        bv.length = size_t(in.pod<uint64_t>());
+        bv.words = in.array<uint64_t>();
+        bv.blockRank = in.array<uint64_t>();
+        if (bv.words.size() != (bv.length + 63) / 64 || bv.blockRank.size() != bv.words.size() / 8 + 1)
+            throw std::runtime_error("Corrupt index file: bitvector sizes");
+        // One popcount pass keeps rank1(i) <= i, which the wavelet matrix relies on
+        uint64_t ones = 0;
+        for (size_t w = 0; w <= bv.words.size(); ++w) {
+            if (w % 8 == 0 && bv.blockRank[w / 8] != ones)
+                throw std::runtime_error("Corrupt index file: rank directory");
+            if (w < bv.words.size()) ones += __builtin_popcountll(bv.words[w]);
+        }
+        return bv;
+    }
+};
+
+// Wavelet matrix over symbol codes [0, 2^levels): rank and access in
+// O(levels) = O(log sigma) popcount steps.
+class WaveletMatrix {
+private:
+    std::vector<RankBitVector> levels;
+    std::vector<size_t> zeros; // number of 0 bits on each level
+
+public:
+    WaveletMatrix() = default;
+
+    WaveletMatrix(std::vector<uint8_t> codes, int bitsPerCode) {
+        size_t n = codes.size();
+        std::vector<uint8_t> next(n);
+        for (int l = 0; l < bitsPerCode; ++l) {
+            int shift = bitsPerCode - 1 - l;
+            std::vector<uint64_t> bits((n + 63) / 64, 0);
+            size_t z = 0;
+            for (size_t i = 0; i < n; ++i) {
+                if ((codes[i] >> shift) & 1) RankBitVector::set(bits, i);
+                else ++z;
+            }
+
+            // Stable partition: zeros first, then ones
+            size_t zi = 0, oi = z;
+            for (size_t i = 0; i < n; ++i)
+                next[((codes[i] >> shift) & 1) ? oi++ : zi++] = codes[i];
+            codes.swap(next);
+
+            levels.emplace_back(std::move(bits), n);
+            zeros.push_back(z);
+        }
+    }
+
+    // Occurrences of code in [0, i)
+    size_t rank(uint8_t code, size_t i) const {
+        size_t s = 0, e = i;
+        int bitsPerCode = int(levels.size());
+        for (int l = 0; l < bitsPerCode; ++l) {
+            if ((code >> (bitsPerCode - 1 - l)) & 1) {
+                s = zeros[l] + levels[l].rank1(s);
+                e = zeros[l] + levels[l].rank1(e);
+            } else {
+                s = levels[l].rank0(s);
+                e = levels[l].rank0(e);
+            }
+        }
+        return e - s;
+    }
+
+    uint8_t access(size_t i) const {
+        uint8_t code = 0;
+        for (size_t l = 0; l < levels.size(); ++l) {
+            bool bit = levels[l].get(i);
+            code = uint8_t(code << 1 | bit);
+            i = bit ? zeros[l] + levels[l].rank1(i) : levels[l].rank0(i);
+        }
+        return code;
+    }
+
+    size_t bytes() const {
+        size_t total = zeros.size() * sizeof(size_t);
+        for (const auto& bv : levels) total += bv.bytes();
+        return total;
+    }
+
+    void save(IndexWriter& out) const {
+        out.pod(uint64_t(levels.size()));
+        for (size_t l = 0; l < levels.size(); ++l) {
+            out.pod(uint64_t(zeros[l]));
+            levels[l].save(out);
+        }
+    }
+
+    // Every level must cover exactly n symbols and agree with its zero count,
+    // so rank() and access() never step outside a bitvector.
+    static WaveletMatrix load(IndexReader& in, size_t n) {
+        WaveletMatrix wm;
+        uint64_t count = in.pod<uint64_t>();
+        if (count < 1 || count > 8) throw std::runtime_error("Corrupt index file: wavelet levels");
+        for (size_t l = 0; l < count; ++l) {
+            wm.zeros.push_back(size_t(in.pod<uint64_t>()));
+            wm.levels.push_back(RankBitVector::load(in));
+            if (wm.levels[l].size() != n || wm.zeros[l] != wm.levels[l].rank0(n))
+                throw std::runtime_error("Corrupt index file: wavelet level " + std::to_string(l));
+        }
+        return wm;
+    }
+
+    size_t levelCount() const { return levels.size(); }
+};
+
+// Compressed FM-index over byte text. Rows are the n+1 sorted suffixes of
+// text + '$'; '$' is kept out of the alphabet and tracked by its BWT row.
 class FMIndex {
 private:
-    std::string text;
-    std::string bwt;
-    std::vector<int> suffixArray;
-    std::vector<std::vector<int>> occ; // Occurrence table
-    std::vector<int> C;                // Count of characters < c
-
-    // Construct BWT using naive suffix array
-    std::string computeBWT(const std::string& s) {
-        std::string t = s + '$';
-        int n = t.length();
-        suffixArray.resize(n);
-        for (int i = 0; i < n; ++i) suffixArray[i] = i;
-
-        std::sort(suffixArray.begin(), suffixArray.end(), [&](int a, int b) {
-            return t.substr(a) < t.substr(b);
-        });
-
-        std::string result;
-        for (int i : suffixArray) {
-            result += (i == 0 ? t[n - 1] : t[i - 1]);
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    // File layout: header, alphabet maps, C, wavelet matrix, sampled SA
+    struct FileHeader {
+        char magic[8];        // "FMINDEX1"
+        uint32_t version;
+        uint32_t byteOrder;
+        uint64_t length;      // n
+        uint64_t dollarRow;
+        uint32_t sampleRate;
+        uint32_t reserved;
+    };
+
+    size_t n = 0;                   // text length (rows = n + 1)
+    size_t dollarRow = 0;           // BWT row holding '$'
+    int sampleRate = 32;            // keep SA[row] when SA[row] % sampleRate == 0
+    std::vector<int16_t> codeOf;    // byte -> dense code, -1 if absent
+    std::vector<uint8_t> symbolOf;  // dense code -> byte
+    std::vector<uint64_t> C;        // C[code] = rows starting with a smaller symbol (incl. '$')
+    WaveletMatrix bwt;              // BWT as codes; '$' stored as code 0 and corrected in occ()
+    RankBitVector sampled;          // rows whose SA value is stored
+    MappedArray<uint32_t> saSamples;
+    std::shared_ptr<MappedFile> mapping; // set when loaded from disk
+
+    FMIndex() = default;
+
+    // Linear-time BWT: SA-IS on the text, then read off the preceding symbol.
+    void build(const std::string& s) {
+        n = s.size();
+        std::vector<int32_t> sa = saIs<int32_t>(reinterpret_cast<const unsigned char*>(s.data()),
+                                                int32_t(n), 255);
+
+        codeOf.assign(256, -1);
+        for (unsigned char ch : s) codeOf[ch] = 0;
+        for (int ch = 0; ch < 256; ++ch) {
+            if (codeOf[ch] == 0) {
+                codeOf[ch] = int16_t(symbolOf.size());
+                symbolOf.push_back(uint8_t(ch));
+            }
         }
-        return result;
+        int bitsPerCode = 1;
+        while ((size_t(1) << bitsPerCode) < symbolOf.size()) ++bitsPerCode;
+
+        C.assign(symbolOf.size() + 1, 0);
+        for (unsigned char ch : s) C[codeOf[ch] + 1]++;
+        C[0] = 1; // the '$' row
+        for (size_t c = 1; c < C.size(); ++c) C[c] += C[c - 1];
+
+        // Row 0 is the suffix "$"; rows 1..n follow the text suffix array
+        std::vector<uint8_t> codes(n + 1);
+        std::vector<uint64_t> sampledBits((n + 1 + 63) / 64, 0);
+        std::vector<uint32_t> samples;
+        auto suffixAt = [&](size_t row) { return row == 0 ? n : size_t(sa[row - 1]); };
+        for (size_t row = 0; row <= n; ++row) {
+            size_t pos = suffixAt(row);
+            if (pos == 0) {
+                dollarRow = row;
+                codes[row] = 0;
+            } else {
+                codes[row] = uint8_t(codeOf[(unsigned char)s[pos - 1]]);
+            }
+            if (pos % sampleRate == 0) {
+                RankBitVector::set(sampledBits, row);
+                samples.push_back(uint32_t(pos));
+            }
+        }
+        sampled = RankBitVector(std::move(sampledBits), n + 1);
+        saSamples = std::move(samples);
+        bwt = WaveletMatrix(std::move(codes), bitsPerCode);
     }
 
-    void buildOcc() {
-        int n = bwt.length();
-        occ.assign(n + 1, std::vector<int>(256, 0));
-        for (int i = 0; i < n; ++i) {
-            occ[i + 1] = occ[i];
-            occ[i + 1][(unsigned char)bwt[i]]++;
+    // Occurrences of code in BWT rows [0, i)
+    size_t occ(size_t code, size_t i) const {
+        size_t r = bwt.rank(uint8_t(code), i);
+        if (code == 0 && i > dollarRow) --r;
+        return r;
+    }
+
+    // LF mapping: row of the suffix one position to the left
+    size_t lf(size_t row) const {
+        uint8_t code = bwt.access(row);
+        return C[code] + occ(code, row);
+    }
+
+    // Each LF step moves one text position left and every multiple of
+    // sampleRate is sampled, so a valid walk stops within sampleRate - 1
+    // steps; a longer one means the sampled bits are corrupt.
+    size_t locate(size_t row) const {
+        size_t steps = 0;
+        while (!sampled.get(row)) {
+            if (++steps >= size_t(sampleRate)) throw std::runtime_error("corrupt index");
+            row = lf(row);
         }
+        return saSamples[sampled.rank1(row)] + steps;
+    }
 
-        C.assign(256, 0);
-        for (int i = 1; i < 256; ++i) {
-            C[i] = C[i - 1] + occ[n][i - 1];
+    // Cross-checks a loaded index against its header so that range(), lf()
+    // and locate() stay in bounds. On top of the O(n / 64) rank-directory pass
+    // this costs O(sigma log sigma + n / sampleRate); the BWT bits themselves
+    // are only checked through their symbol counts.
+    void validate(const std::string& path) const {
+        auto fail = [&](const char* what) { throw std::runtime_error(path + ": corrupt index (" + what + ")"); };
+        size_t sigma = symbolOf.size();
+        if (codeOf.size() != 256) fail("alphabet map size");
+        for (size_t c = 0; c < sigma; ++c)
+            if (codeOf[symbolOf[c]] != int16_t(c)) fail("alphabet maps disagree");
+        for (int16_t code : codeOf)
+            if (code < -1 || code >= int16_t(sigma)) fail("alphabet code");
+
+        int bitsPerCode = 1;
+        while ((size_t(1) << bitsPerCode) < sigma) ++bitsPerCode;
+        if (bwt.levelCount() != size_t(bitsPerCode)) fail("wavelet depth");
+
+        // C must count each symbol exactly as often as the BWT holds it; '$'
+        // is stored as code 0, and together they account for all n + 1 rows.
+        if (C.size() != sigma + 1 || C[0] != 1 || C[sigma] != n + 1) fail("symbol counts");
+        size_t rows = 0;
+        for (size_t c = 0; c < sigma; ++c) {
+            if (C[c + 1] < C[c]) fail("symbol counts");
+            size_t inBwt = bwt.rank(uint8_t(c), n + 1) - (c == 0 ? 1 : 0);
+            if (C[c + 1] - C[c] != inBwt) fail("symbol counts");
+            rows += inBwt;
         }
+        if (rows != n || (sigma > 0 && bwt.access(dollarRow) != 0) || (sigma == 0 && dollarRow != 0))
+            fail("BWT rows");
+
+        size_t expected = n / size_t(sampleRate) + 1;
+        if (sampled.size() != n + 1 || sampled.rank1(n + 1) != expected || saSamples.size() != expected)
+            fail("SA samples");
+        for (uint32_t pos : saSamples)
+            if (pos > n || pos % uint32_t(sampleRate) != 0) fail("SA samples");
     }
 
 public:
-    FMIndex(const std::string& s) : text(s) {
-        bwt = computeBWT(s);
-        buildOcc();
+    FMIndex(const std::string& s, int saSampleRate = 32) : sampleRate(saSampleRate) {
+        build(s);
+    }
+
+    void save(const std::string& path) const {
+        FileHeader h{{'F', 'M', 'I', 'N', 'D', 'E', 'X', '1'}, FORMAT_VERSION, INDEX_BYTE_ORDER,
+                     n, dollarRow, uint32_t(sampleRate), 0};
+        IndexWriter out(path);
+        out.pod(h);
+        out.array(codeOf);
+        out.array(symbolOf);
+        out.array(C);
+        bwt.save(out);
+        sampled.save(out);
+        out.array(saSamples);
+    }
+
+    // Zero-copy open: bitvectors and SA samples stay in the read-only mapping
+    static FMIndex load(const std::string& path) {
+        auto file = std::make_shared<MappedFile>(path);
+        IndexReader in(*file);
+        FileHeader h = in.pod<FileHeader>();
+        if (std::memcmp(h.magic, "FMINDEX1", 8) != 0)
+            throw std::runtime_error(path + " is not an FM-index");
+        if (h.version != FORMAT_VERSION || h.byteOrder != INDEX_BYTE_ORDER)
+            throw std::runtime_error(path + ": unsupported version or byte order");
+
+        // SA samples are uint32_t positions, and sampleRate must divide them
+        if (h.length >= UINT32_MAX || h.dollarRow > h.length || h.sampleRate < 1 || h.sampleRate > INT32_MAX)
+            throw std::runtime_error(path + ": corrupt header");
+
+        FMIndex fm;
+        fm.n = size_t(h.length);
+        fm.dollarRow = size_t(h.dollarRow);
+        fm.sampleRate = int(h.sampleRate);
+        auto codes = in.array<int16_t>();
+        auto symbols = in.array<uint8_t>();
+        auto counts = in.array<uint64_t>();
+        fm.codeOf.assign(codes.begin(), codes.end());
+        fm.symbolOf.assign(symbols.begin(), symbols.end());
+        fm.C.assign(counts.begin(), counts.end());
+        fm.bwt = WaveletMatrix::load(in, fm.n + 1);
+        fm.sampled = RankBitVector::load(in);
+        fm.saSamples = in.array<uint32_t>();
+        fm.validate(path);
+        fm.mapping = std::move(file);
+        return fm;
     }
 
-    std::vector<int> search(const std::string& pattern) {
-        int left = 0, right = bwt.length() - 1;
-        for (int i = pattern.length() - 1; i >= 0 && left <= right; --i) {
-            unsigned char c = pattern[i];
-            left = C[c] + (left > 0 ? occ[left][c] : 0);
-            right = C[c] + occ[right + 1][c] - 1;
+    // Backward search: O(m log sigma), returns the half-open row range [lo, hi)
+    std::pair<size_t, size_t> range(const std::string& pattern) const {
+        size_t lo = 0, hi = n + 1;
+        for (size_t i = pattern.size(); i-- > 0 && lo < hi;) {
+            int code = codeOf[(unsigned char)pattern[i]];
+            if (code < 0) return {0, 0};
+            lo = C[code] + occ(code, lo);
+            hi = C[code] + occ(code, hi);
         }
+        return {lo, hi};
+    }
+
+    size_t count(const std::string& pattern) const {
+        auto [lo, hi] = range(pattern);
+        return hi > lo ? hi - lo : 0;
+    }
 
+    std::vector<int> search(const std::string& pattern) const {
+        auto [lo, hi] = range(pattern);
         std::vector<int> result;
-        if (left <= right) {
-            for (int i = left; i <= right; ++i)
-                result.push_back(suffixArray[i]);
-            std::sort(result.begin(), result.end()); // optional
-        }
+        for (size_t row = lo; row < hi; ++row)
+            result.push_back(int(locate(row)));
+        std::sort(result.begin(), result.end()); // optional
         return result;
     }
 
-    void print() {
+    // Recover the text from the index by walking LF from the '$' row
+    std::string extractText() const {
+        std::string t(n, '\0');
+        size_t row = 0;
+        for (size_t i = n; i-- > 0;) {
+            t[i] = char(symbolOf[bwt.access(row)]);
+            row = lf(row);
+        }
+        return t;
+    }
+
+    size_t bytes() const {
+        return bwt.bytes() + sampled.bytes() + saSamples.size() * sizeof(uint32_t) +
+               C.size() * sizeof(uint64_t) + codeOf.size() * sizeof(int16_t) + symbolOf.size();
+    }
+
+    void print() const {
+        std::string text = extractText();
         std::cout << "Suffix Array:\n";
-        for (int i = 0; i < suffixArray.size(); ++i)
-            std::cout << std::setw(2) << suffixArray[i] << ": " << text.substr(suffixArray[i]) << "\n";
+        for (size_t row = 0; row <= n; ++row) {
+            size_t pos = locate(row);
+            std::cout << std::setw(2) << pos << ": " << text.substr(pos) << "$\n";
+        }
 
-        std::cout << "\nBWT: " << bwt << "\n";
+        std::cout << "\nBWT: ";
+        for (size_t row = 0; row <= n; ++row)
+            std::cout << (row == dollarRow ? '$' : char(symbolOf[bwt.access(row)]));
+        std::cout << "\n";
     }
 };
 
@@ -89,5 +694,68 @@ int main() {
     else for (int p : positions) std::cout << p << " ";
     std::cout << "\n";
 
+    // --- Index size on larger inputs ---
+    std::cout << "\n--- Index Size ---\n";
+    std::mt19937 rng(7);
+    std::string dna(1 << 22, 'A');
+    for (char& c : dna) c = "ACGT"[rng() % 4];
+    std::string english;
+    const char* words[] = {"the ", "quick ", "brown ", "fox ", "jumps ", "over ", "lazy ", "dog ",
+                           "and ", "runs ", "away, ", "then ", "sleeps. "};
+    while (english.size() < (1 << 22)) english += words[rng() % 13];
+
+    for (auto [name, corpus] : {std::pair<const char*, const std::string*>{"DNA", &dna},
+                                {"English-like", &english}}) {
+        auto t0 = std::chrono::steady_clock::now();
+        FMIndex index(*corpus);
+        auto t1 = std::chrono::steady_clock::now();
+
+        size_t found = 0;
+        const int queries = 100000;
+        for (int q = 0; q < queries; ++q)
+            found += index.count(corpus->substr(rng() % (corpus->size() - 12), 12));
+        auto t2 = std::chrono::steady_clock::now();
+
+        double denseMiB = double(corpus->size() + 2) * 256 * sizeof(int) / (1 << 20);
+
+        // Every reported position must hold the pattern, and its known source must be among them
+        std::string pattern = corpus->substr(1000, 20);
+        std::vector<int> hits = index.search(pattern);
+        bool located = std::find(hits.begin(), hits.end(), 1000) != hits.end();
+        for (int p : hits) located = located && corpus->compare(size_t(p), pattern.size(), pattern) == 0;
+
+        std::cout << name << " (n=" << corpus->size() << ")\n"
+                  << "  build:        " << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms\n"
+                  << "  index size:   " << double(index.bytes()) / (1 << 20) << " MiB ("
+                  << 8.0 * index.bytes() / corpus->size() << " bits/symbol)\n"
+                  << "  dense Occ:    " << denseMiB << " MiB\n"
+                  << "  count():      " << std::chrono::duration<double, std::micro>(t2 - t1).count() / queries
+                  << " us/query (" << found << " hits)\n"
+                  << "  locate check: " << (located ? "ok" : "FAILED") << " (" << hits.size() << " hits)\n";
+    }
+
+    // Build once, then reopen the saved index instead of rebuilding
+    std::cout << "\n--- On-disk Index ---\n";
+    const std::string indexPath = "fm_index.idx";
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        FMIndex built(english);
+        auto t1 = std::chrono::steady_clock::now();
+        built.save(indexPath);
+        auto t2 = std::chrono::steady_clock::now();
+        FMIndex loaded = FMIndex::load(indexPath);
+        auto t3 = std::chrono::steady_clock::now();
+        auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+
+        std::string probe = "lazy dog and";
+        std::cout << "  build: " << ms(t0, t1) << " ms, save: " << ms(t1, t2) << " ms, mmap load: " << ms(t2, t3)
+                  << " ms\n"
+                  << "  loaded index agrees on '" << probe << "': "
+                  << (loaded.count(probe) == built.count(probe) && loaded.search(probe) == built.search(probe)
+                          ? "yes" : "NO")
+                  << " (" << loaded.count(probe) << " hits)\n";
+    } // unmap before deleting the file
+    std::remove(indexPath.c_str());
+
     return 0;
 }
@@ -1,111 +1,1024 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <functional>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
 #include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
+#if defined(__x86_64__) || defined(__i386__)
+#define MERKLE_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+using Digest = std::array<uint8_t, 32>;
+
+std::string toHex(const Digest& d, size_t bytes = 32) {
+    std::stringstream ss;
+    for (size_t i = 0; i < bytes; i++)
+        ss << std::hex << std::setw(2) << std::setfill('0') << int(d[i]);
+    return ss.str();
+}
+
+/*
+ * Self-contained SHA-256 (FIPS 180-4) with three interchangeable engines:
+ *   - Scalar: portable reference compression function.
+ *   - Avx2x8: hashes eight equal-length messages at once, one per 32-bit
+ *             AVX2 lane. Merkle levels are a perfect fit, since every
+ *             internal node hashes exactly 65 bytes.
+ *   - ShaNi:  the x86 SHA extensions, one message at a time.
+ * The best engine the CPU supports is picked on first use; setBackend()
+ * overrides it so the benchmark can compare them.
+ *
+ * Every message may carry a one-byte tag in front of it. The Merkle tree
+ * uses it for domain separation (0x00 leaves, 0x01 nodes) so a leaf can
+ * never be passed off as an internal node.
+ */
+class Sha256 {
+public:
+    enum Backend { Scalar, Avx2x8, ShaNi };
+
+private:
+    static constexpr uint32_t K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    static constexpr uint32_t IV[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    // Hashing runs on parallelFor workers, so the first detect() may race;
+    // call_once picks the engine exactly once and the atomic publishes it.
+    inline static std::atomic<Backend> active{Scalar};
+    inline static std::once_flag detectOnce;
+
+    static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    static uint32_t loadBE(const uint8_t* p) {
+        return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+    }
+
+    static void storeBE(uint8_t* p, uint32_t v) {
+        p[0] = uint8_t(v >> 24); p[1] = uint8_t(v >> 16); p[2] = uint8_t(v >> 8); p[3] = uint8_t(v);
+    }
+
+    static void compressScalar(uint32_t state[8], const uint8_t* data, size_t blocks) {
+        for (; blocks > 0; blocks--, data += 64) {
+            uint32_t w[64];
+            for (int t = 0; t < 16; t++) w[t] = loadBE(data + 4 * t);
+            for (int t = 16; t < 64; t++) {
+                uint32_t s0 = rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+                uint32_t s1 = rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+                w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+            }
+            uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+            uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+            for (int t = 0; t < 64; t++) {
+                uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[t] + w[t];
+                uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                h = g; g = f; f = e; e = d + t1;
+                d = c; c = b; b = a; a = t1 + t2;
+            }
+            state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+            state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        }
+    }
+
+#ifdef MERKLE_X86
+    __attribute__((target("sha,sse4.1")))
+    static void compressShaNi(uint32_t state[8], const uint8_t* data, size_t blocks) {
+        const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        // The SHA instructions want the state split as ABEF / CDGH.
+        __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xB1);
+        __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1B);
+        __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+        state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+        for (; blocks > 0; blocks--, data += 64) {
+            __m128i abefSave = state0, cdghSave = state1;
+            __m128i w[4];
+            for (int i = 0; i < 4; i++)
+                w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16 * i)), byteSwap);
+
+            // Sixteen groups of four rounds; the message schedule for group
+            // g + 1 is finished (msg2) and for g + 3 started (msg1) in step.
+#pragma GCC unroll 16
+            for (int g = 0; g < 16; g++) {
+                __m128i msg = _mm_add_epi32(w[g & 3], _mm_loadu_si128((const __m128i*)&K[4 * g]));
+                state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+                if (g >= 3 && g <= 14) {
+                    __m128i& next = w[(g + 1) & 3];
+                    next = _mm_add_epi32(next, _mm_alignr_epi8(w[g & 3], w[(g + 3) & 3], 4));
+                    next = _mm_sha256msg2_epu32(next, w[g & 3]);
+                }
+                state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+                if (g >= 1 && g <= 12) w[(g + 3) & 3] = _mm_sha256msg1_epu32(w[(g + 3) & 3], w[g & 3]);
+            }
+            state0 = _mm_add_epi32(state0, abefSave);
+            state1 = _mm_add_epi32(state1, cdghSave);
+        }
+
+        tmp = _mm_shuffle_epi32(state0, 0x1B);
+        state1 = _mm_shuffle_epi32(state1, 0xB1);
+        _mm_storeu_si128((__m128i*)&state[0], _mm_blend_epi16(tmp, state1, 0xF0));
+        _mm_storeu_si128((__m128i*)&state[4], _mm_alignr_epi8(state1, tmp, 8));
+    }
+
+    __attribute__((target("avx2")))
+    static __m256i rotr8x(__m256i x, int n) {
+        return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+    }
+
+    // Eight tagged messages of the same length, one per lane.
+    __attribute__((target("avx2")))
+    static void hashTagged8(uint8_t tag, const uint8_t* const msgs[8], size_t len, Digest* out) {
+        __m256i s[8];
+        for (int i = 0; i < 8; i++) s[i] = _mm256_set1_epi32(int(IV[i]));
+
+        size_t total = len + 1, blocks = (total + 8) / 64 + 1;
+        alignas(32) uint8_t scratch[8][64];
+        for (size_t j = 0; j < blocks; j++) {
+            const uint8_t* src[8];
+            for (int lane = 0; lane < 8; lane++) {
+                if (64 * j >= 1 && 64 * j + 63 <= len) {
+                    src[lane] = msgs[lane] + 64 * j - 1;
+                } else {
+                    fillBlock(scratch[lane], tag, msgs[lane], len, j);
+                    src[lane] = scratch[lane];
+                }
+            }
+
+            __m256i w[16];
+            for (int t = 0; t < 16; t++)
+                w[t] = _mm256_setr_epi32(int(loadBE(src[0] + 4 * t)), int(loadBE(src[1] + 4 * t)),
+                                         int(loadBE(src[2] + 4 * t)), int(loadBE(src[3] + 4 * t)),
+                                         int(loadBE(src[4] + 4 * t)), int(loadBE(src[5] + 4 * t)),
+                                         int(loadBE(src[6] + 4 * t)), int(loadBE(src[7] + 4 * t)));
+
+            __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+            for (int t = 0; t < 64; t++) {
+                if (t >= 16) {
+                    __m256i w15 = w[(t - 15) & 15], w2 = w[(t - 2) & 15];
+                    __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(w15, 7), rotr8x(w15, 18)),
+                                                  _mm256_srli_epi32(w15, 3));
+                    __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(w2, 17), rotr8x(w2, 19)),
+                                                  _mm256_srli_epi32(w2, 10));
+                    w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], s0),
+                                                 _mm256_add_epi32(w[(t - 7) & 15], s1));
+                }
+                __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(e, 6), rotr8x(e, 11)), rotr8x(e, 25));
+                __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+                __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, sigma1),
+                                              _mm256_add_epi32(ch, _mm256_add_epi32(w[t & 15], _mm256_set1_epi32(int(K[t])))));
+                __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(rotr8x(a, 2), rotr8x(a, 13)), rotr8x(a, 22));
+                __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+                h = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+                d = c; c = b; b = a; a = _mm256_add_epi32(t1, _mm256_add_epi32(sigma0, maj));
+            }
+            s[0] = _mm256_add_epi32(s[0], a); s[1] = _mm256_add_epi32(s[1], b);
+            s[2] = _mm256_add_epi32(s[2], c); s[3] = _mm256_add_epi32(s[3], d);
+            s[4] = _mm256_add_epi32(s[4], e); s[5] = _mm256_add_epi32(s[5], f);
+            s[6] = _mm256_add_epi32(s[6], g); s[7] = _mm256_add_epi32(s[7], h);
+        }
+
+        alignas(32) uint32_t words[8][8];
+        for (int i = 0; i < 8; i++) _mm256_store_si256((__m256i*)words[i], s[i]);
+        for (int lane = 0; lane < 8; lane++)
+            for (int i = 0; i < 8; i++) storeBE(out[lane].data() + 4 * i, words[i][lane]);
+    }
+#endif
+
+    static void compress(uint32_t state[8], const uint8_t* data, size_t blocks) {
+#ifdef MERKLE_X86
+        if (active.load(std::memory_order_relaxed) == ShaNi) return compressShaNi(state, data, blocks);
+#endif
+        compressScalar(state, data, blocks);
+    }
+
+    // Block j of the padded message tag || msg (msg is len bytes).
+    static void fillBlock(uint8_t out[64], uint8_t tag, const uint8_t* msg, size_t len, size_t j) {
+        size_t total = len + 1, begin = 64 * j;
+        std::memset(out, 0, 64);
+        for (size_t p = begin; p < begin + 64; ) {
+            if (p == 0) {
+                out[0] = tag;
+                p++;
+            } else if (p <= len) {
+                size_t n = std::min(begin + 64, len + 1) - p;
+                std::memcpy(out + (p - begin), msg + p - 1, n);
+                p += n;
+            } else {
+                if (p == total) out[p - begin] = 0x80;
+                break;
+            }
+        }
+        size_t blocks = (total + 8) / 64 + 1;
+        if (j == blocks - 1) {
+            uint64_t bits = uint64_t(total) * 8;
+            for (int i = 0; i < 8; i++) out[56 + i] = uint8_t(bits >> (56 - 8 * i));
+        }
+    }
+
+    static void detect() {
+        std::call_once(detectOnce, [] {
+            active.store(supported(ShaNi) ? ShaNi : supported(Avx2x8) ? Avx2x8 : Scalar, std::memory_order_relaxed);
+        });
+    }
+
+public:
+    static bool supported(Backend b) {
+#ifdef MERKLE_X86
+        unsigned eax, ebx, ecx, edx;
+        if (b == ShaNi)
+            return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1u << 29)) &&
+                   __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 19));
+        if (b == Avx2x8)
+            return __builtin_cpu_supports("avx2");
+#endif
+        return b == Scalar;
+    }
+
+    static void setBackend(Backend b) {
+        std::call_once(detectOnce, [] {}); // an explicit choice is never overwritten by detect()
+        active.store(supported(b) ? b : Scalar, std::memory_order_relaxed);
+    }
+
+    static Backend backend() {
+        detect();
+        return active.load(std::memory_order_relaxed);
+    }
+
+    static const char* name(Backend b) {
+        return b == ShaNi ? "SHA-NI" : b == Avx2x8 ? "AVX2 x8" : "scalar";
+    }
+
+    // SHA-256(tag || msg).
+    static Digest hashTagged(uint8_t tag, const uint8_t* msg, size_t len) {
+        detect();
+        uint32_t state[8];
+        std::memcpy(state, IV, sizeof(state));
+        size_t blocks = (len + 9) / 64 + 1;
+        uint8_t scratch[64];
+        // Blocks that lie wholly inside msg are compressed in place.
+        size_t j = 0;
+        for (; j < blocks; j++) {
+            if (64 * j >= 1 && 64 * j + 63 <= len) {
+                size_t run = 1;
+                while (j + run < blocks && 64 * (j + run) + 63 <= len) run++;
+                compress(state, msg + 64 * j - 1, run);
+                j += run - 1;
+                continue;
+            }
+            fillBlock(scratch, tag, msg, len, j);
+            compress(state, scratch, 1);
+        }
+        Digest out;
+        for (int i = 0; i < 8; i++) storeBE(out.data() + 4 * i, state[i]);
+        return out;
+    }
+
+    // Plain SHA-256 of msg: the tagged path with the tag peeled back off.
+    static Digest hash(const uint8_t* msg, size_t len) {
+        if (len == 0) {
+            uint8_t empty[64] = {0x80};
+            uint32_t state[8];
+            std::memcpy(state, IV, sizeof(state));
+            detect();
+            compress(state, empty, 1);
+            Digest out;
+            for (int i = 0; i < 8; i++) storeBE(out.data() + 4 * i, state[i]);
+            return out;
+        }
+        return hashTagged(msg[0], msg + 1, len - 1);
+    }
+
+    // out[i] = SHA-256(tag || base + i * stride), every message len bytes.
+    static void hashTaggedBatch(uint8_t tag, const uint8_t* base, size_t stride, size_t len,
+                                size_t count, Digest* out) {
+        detect();
+        size_t i = 0;
+#ifdef MERKLE_X86
+        if (active.load(std::memory_order_relaxed) == Avx2x8) {
+            for (; i + 8 <= count; i += 8) {
+                const uint8_t* msgs[8];
+                for (int lane = 0; lane < 8; lane++) msgs[lane] = base + (i + lane) * stride;
+                hashTagged8(tag, msgs, len, out + i);
+            }
+        }
+#endif
+        for (; i < count; i++) out[i] = hashTagged(tag, base + i * stride, len);
+    }
+};
+
+// Splits [0, n) into one contiguous range per hardware thread.
+template <typename Fn>
+void parallelFor(size_t n, size_t minChunk, Fn fn) {
+    static const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    size_t threads = std::min(hardware, (n + minChunk - 1) / minChunk);
+    if (threads <= 1) {
+        fn(size_t(0), n);
+        return;
+    }
+    std::vector<std::thread> pool;
+    size_t per = (n + threads - 1) / threads;
+    for (size_t begin = 0; begin < n; begin += per)
+        pool.emplace_back(fn, begin, std::min(n, begin + per));
+    for (auto& t : pool) t.join();
+}
+
+/*
+ * Merkle tree over 32-byte SHA-256 digests.
+ *   - leaf = SHA-256(0x00 || block), node = SHA-256(0x01 || left || right)
+ *   - Each level is one flat array of digests; a node's children are the
+ *     64 contiguous bytes at 2i in the level below, hashed in place.
+ *   - An odd node at the end of a level is promoted unchanged instead of
+ *     being paired with a copy of itself, so [a, b, c] and [a, b, c, c]
+ *     get different roots.
+ */
 class MerkleTree {
 private:
-    std::vector<std::string> dataBlocks;
-    std::vector<std::vector<std::string>> tree;
-
-    // Use std::hash for demo purposes; in real-world, use SHA-256 or Keccak
-    std::string hash(const std::string& data) {
-        std::hash<std::string> hasher;
-        size_t hashed = hasher(data);
-        std::stringstream ss;
-        ss << std::hex << hashed;
-        return ss.str();
-    }
-
-    void buildTree() {
-        std::vector<std::string> currentLevel;
-        for (const auto& data : dataBlocks)
-            currentLevel.push_back(hash(data));
-
-        tree.push_back(currentLevel);
-
-        while (currentLevel.size() > 1) {
-            std::vector<std::string> nextLevel;
-            for (size_t i = 0; i < currentLevel.size(); i += 2) {
-                std::string left = currentLevel[i];
-                std::string right = (i + 1 < currentLevel.size()) ? currentLevel[i + 1] : left;
-                nextLevel.push_back(hash(left + right));
+    static constexpr uint8_t LEAF_TAG = 0x00;
+    static constexpr uint8_t NODE_TAG = 0x01;
+
+    std::vector<std::vector<Digest>> levels;
+
+    // Rehashes every ancestor of leaves [lo, hi) after they changed or
+    // were appended, adding levels on top as the tree grows. Construction
+    // is the special case refresh(0, n); a single update touches one node
+    // per level.
+    void refresh(size_t lo, size_t hi) {
+        for (size_t level = 0; levels[level].size() > 1; level++) {
+            if (level + 1 == levels.size()) levels.emplace_back();
+            const std::vector<Digest>& cur = levels[level];
+            std::vector<Digest>& up = levels[level + 1];
+            size_t width = cur.size();
+            up.resize((width + 1) / 2);
+
+            size_t upLo = lo / 2, upHi = (hi + 1) / 2;
+            size_t pairEnd = std::min(upHi, width / 2);
+            if (upLo < pairEnd) {
+                nodeHashPairs(&cur[2 * upLo], pairEnd - upLo, &up[upLo]);
             }
-            tree.push_back(nextLevel);
-            currentLevel = nextLevel;
+            if (width % 2 && upHi == up.size()) up.back() = cur.back();
+            lo = upLo;
+            hi = upHi;
         }
     }
 
+    // Ascending, duplicate-free copy of the requested leaf indices.
+    static std::vector<size_t> normalize(std::vector<size_t> indices) {
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        return indices;
+    }
+
 public:
-    MerkleTree(const std::vector<std::string>& blocks) : dataBlocks(blocks) {
-        buildTree();
+    MerkleTree() : levels(1) {}
+
+    MerkleTree(const std::vector<std::string>& blocks) : levels(1) {
+        append(blocks);
+    }
+
+    // Splits a buffer into blockSize-byte leaves (the last may be shorter).
+    MerkleTree(const uint8_t* data, size_t size, size_t blockSize) : levels(1) {
+        size_t full = size / blockSize, count = (size + blockSize - 1) / blockSize;
+        std::vector<Digest>& leaves = levels[0];
+        leaves.resize(count);
+        leafHashBlocks(data, blockSize, full, leaves.data());
+        if (full < count) leaves.back() = leafHash(data + full * blockSize, size - full * blockSize);
+        refresh(0, count);
+    }
+
+    static Digest leafHash(const uint8_t* data, size_t len) {
+        return Sha256::hashTagged(LEAF_TAG, data, len);
+    }
+
+    static Digest nodeHash(const Digest& left, const Digest& right) {
+        uint8_t pair[64];
+        std::memcpy(pair, left.data(), 32);
+        std::memcpy(pair + 32, right.data(), 32);
+        return Sha256::hashTagged(NODE_TAG, pair, 64);
+    }
+
+    // out[i] = leafHash of the i-th blockSize-byte block, split across threads.
+    static void leafHashBlocks(const uint8_t* data, size_t blockSize, size_t count, Digest* out) {
+        parallelFor(count, 64, [&](size_t begin, size_t end) {
+            Sha256::hashTaggedBatch(LEAF_TAG, data + begin * blockSize, blockSize, blockSize, end - begin,
+                                    out + begin);
+        });
+    }
+
+    // out[i] = nodeHash(children[2i], children[2i + 1]), split across threads.
+    static void nodeHashPairs(const Digest* children, size_t pairs, Digest* out) {
+        parallelFor(pairs, 4096, [&](size_t begin, size_t end) {
+            Sha256::hashTaggedBatch(NODE_TAG, children[2 * begin].data(), 64, 64, end - begin, out + begin);
+        });
+    }
+
+    // Reads the flat level file written by StreamingMerkleBuilder.
+    static MerkleTree fromLevelFile(const std::string& path);
+
+    // The empty tree's root is SHA-256 of the empty string.
+    const Digest& getMerkleRoot() const {
+        static const Digest empty = Sha256::hash(nullptr, 0);
+        return levels[0].empty() ? empty : levels.back()[0];
+    }
+
+    // Replaces one block and rehashes only its path to the root.
+    void update(size_t index, const std::string& data) {
+        if (index >= leafCount()) throw std::out_of_range("MerkleTree::update: leaf index out of range");
+        levels[0][index] = leafHash((const uint8_t*)data.data(), data.size());
+        refresh(index, index + 1);
     }
 
-    std::string getMerkleRoot() const {
-        return tree.back()[0];
+    // Adds blocks at the end; only the right edge of each level is rehashed.
+    void append(const std::vector<std::string>& blocks) {
+        std::vector<Digest>& leaves = levels[0];
+        size_t old = leaves.size();
+        leaves.resize(old + blocks.size());
+        parallelFor(blocks.size(), 256, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+                leaves[old + i] = leafHash((const uint8_t*)blocks[i].data(), blocks[i].size());
+        });
+        refresh(old, leaves.size());
     }
 
+    void append(const std::string& block) {
+        append(std::vector<std::string>{block});
+    }
+
+    size_t leafCount() const { return levels[0].size(); }
+
     void printTree() const {
         std::cout << "Merkle Tree Structure:\n";
-        for (int level = tree.size() - 1; level >= 0; --level) {
+        for (int level = levels.size() - 1; level >= 0; --level) {
             std::cout << "Level " << level << ": ";
-            for (const auto& h : tree[level])
-                std::cout << "[" << h.substr(0, 8) << "] "; // Shortened hash
+            for (const auto& h : levels[level])
+                std::cout << "[" << toHex(h, 4) << "] "; // Shortened hash
             std::cout << "\n";
         }
     }
 
-    // Generate Merkle proof for block at index
-    std::vector<std::string> generateProof(size_t index) {
-        std::vector<std::string> proof;
-        if (index >= tree[0].size()) return proof;
-
-        for (size_t level = 0; level < tree.size() - 1; ++level) {
-            size_t siblingIndex = (index % 2 == 0) ? index + 1 : index - 1;
-            if (siblingIndex >= tree[level].size())
-                proof.push_back(tree[level][index]); // duplicate last if no sibling
-            else
-                proof.push_back(tree[level][siblingIndex]);
+    // Sibling digests from the leaf up; promoted levels contribute nothing.
+    std::vector<Digest> generateProof(size_t index) const {
+        std::vector<Digest> proof;
+        if (index >= leafCount()) return proof;
 
+        for (size_t level = 0; level + 1 < levels.size(); ++level) {
+            size_t siblingIndex = index ^ 1;
+            if (siblingIndex < levels[level].size())
+                proof.push_back(levels[level][siblingIndex]);
             index /= 2;
         }
         return proof;
     }
 
-    bool verifyProof(const std::string& data, const std::vector<std::string>& proof, const std::string& root, size_t index) {
-        std::string currentHash = hash(data);
-        for (const auto& siblingHash : proof) {
-            if (index % 2 == 0)
-                currentHash = hash(currentHash + siblingHash);
-            else
-                currentHash = hash(siblingHash + currentHash);
-            index /= 2;
+    // leafCount is needed to know at which levels the path was promoted.
+    static bool verifyProof(const std::string& data, const std::vector<Digest>& proof, const Digest& root,
+                            size_t index, size_t leafCount) {
+        if (index >= leafCount) return false;
+        Digest current = leafHash((const uint8_t*)data.data(), data.size());
+        size_t used = 0;
+        for (size_t width = leafCount; width > 1; width = (width + 1) / 2, index /= 2) {
+            if ((index ^ 1) >= width) continue;
+            if (used == proof.size()) return false;
+            const Digest& sibling = proof[used++];
+            current = index % 2 == 0 ? nodeHash(current, sibling) : nodeHash(sibling, current);
+        }
+        return used == proof.size() && current == root;
+    }
+
+    // One proof for many leaves. Siblings shared between paths, or that
+    // are themselves on a proven path, are sent once or not at all. Digests
+    // are ordered level by level, left to right.
+    std::vector<Digest> generateMultiProof(const std::vector<size_t>& indices) const {
+        std::vector<Digest> proof;
+        std::vector<size_t> known = normalize(indices);
+        if (known.empty() || known.back() >= leafCount()) return proof;
+
+        for (size_t level = 0; level + 1 < levels.size(); ++level) {
+            size_t width = levels[level].size();
+            for (size_t k = 0; k < known.size(); k++) {
+                size_t i = known[k];
+                if (i % 2 == 0 && k + 1 < known.size() && known[k + 1] == i + 1)
+                    k++; // both children known, nothing to send
+                else if ((i ^ 1) < width)
+                    proof.push_back(levels[level][i ^ 1]);
+            }
+            for (size_t& i : known) i /= 2;
+            known.erase(std::unique(known.begin(), known.end()), known.end());
+        }
+        return proof;
+    }
+
+    static bool verifyMultiProof(const std::vector<std::pair<size_t, std::string>>& leaves,
+                                 const std::vector<Digest>& proof, const Digest& root, size_t leafCount) {
+        std::vector<std::pair<size_t, Digest>> nodes;
+        for (const auto& [index, data] : leaves) {
+            if (index >= leafCount) return false;
+            nodes.emplace_back(index, leafHash((const uint8_t*)data.data(), data.size()));
+        }
+        std::sort(nodes.begin(), nodes.end());
+        for (size_t k = 1; k < nodes.size(); k++)
+            if (nodes[k].first == nodes[k - 1].first && nodes[k].second != nodes[k - 1].second) return false;
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+        if (nodes.empty()) return false;
+
+        size_t used = 0;
+        for (size_t width = leafCount; width > 1; width = (width + 1) / 2) {
+            std::vector<std::pair<size_t, Digest>> parents;
+            for (size_t k = 0; k < nodes.size(); k++) {
+                auto [i, digest] = nodes[k];
+                if (i % 2 == 0 && k + 1 < nodes.size() && nodes[k + 1].first == i + 1) {
+                    digest = nodeHash(digest, nodes[++k].second);
+                } else if ((i ^ 1) < width) {
+                    if (used == proof.size()) return false;
+                    const Digest& sibling = proof[used++];
+                    digest = i % 2 == 0 ? nodeHash(digest, sibling) : nodeHash(sibling, digest);
+                }
+                parents.emplace_back(i / 2, digest);
+            }
+            nodes.swap(parents);
+        }
+        return used == proof.size() && nodes[0].second == root;
+    }
+};
+
+// ---------- Streaming construction for files larger than memory ----------
+
+const uint32_t INDEX_BYTE_ORDER = 0x01020304; // catches files written on the other endianness
+
+// Level file layout: header, then every level as a flat digest array,
+// leaves first and the root last. Same shape as MerkleTree's levels.
+struct LevelFileHeader {
+    char magic[8];        // "MRKLEVEL"
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t blockSize;
+    uint64_t leafCount;
+    uint32_t levelCount;
+    uint32_t reserved;
+};
+
+const uint32_t LEVEL_FILE_VERSION = 1;
+
+// Widths of every level for n leaves, following MerkleTree's promotion rule.
+std::vector<uint64_t> levelWidths(uint64_t n) {
+    std::vector<uint64_t> widths{n};
+    while (widths.back() > 1) widths.push_back((widths.back() + 1) / 2);
+    return widths;
+}
+
+// Walks a file through a sliding read-only mapping of chunkBytes at a time,
+// so address space and resident pages stay bounded however big the file is.
+class ChunkedFileReader {
+private:
+    uint64_t length = 0;
+    uint64_t offset = 0;
+    size_t chunk;
+    void* view = nullptr;
+    size_t viewBytes = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+
+    void unmap() {
+        if (!view) return;
+#ifdef _WIN32
+        UnmapViewOfFile(view);
+#else
+        munmap(view, viewBytes);
+#endif
+        view = nullptr;
+    }
+
+public:
+    ChunkedFileReader(const std::string& path, size_t chunkBytes) : chunk(chunkBytes) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open " + path);
+        // The destructor does not run if the constructor throws, so close here
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        length = uint64_t(size.QuadPart);
+        if (length > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) {
+                CloseHandle(file);
+                throw std::runtime_error("Cannot map " + path);
+            }
         }
-        return currentHash == root;
+#else
+        fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Cannot open " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw std::runtime_error("Cannot stat " + path);
+        }
+        length = uint64_t(st.st_size);
+#endif
+    }
+
+    ~ChunkedFileReader() {
+        unmap();
+#ifdef _WIN32
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    ChunkedFileReader(const ChunkedFileReader&) = delete;
+    ChunkedFileReader& operator=(const ChunkedFileReader&) = delete;
+
+    uint64_t size() const { return length; }
+
+    // Maps the next chunk, releasing the previous one. False at end of file.
+    bool next(const uint8_t*& data, size_t& len) {
+        unmap();
+        if (offset >= length) return false;
+        len = size_t(std::min<uint64_t>(chunk, length - offset));
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        uint64_t aligned = offset - offset % info.dwAllocationGranularity;
+        viewBytes = size_t(offset - aligned) + len;
+        view = MapViewOfFile(mapping, FILE_MAP_READ, DWORD(aligned >> 32), DWORD(aligned), viewBytes);
+        if (!view) throw std::runtime_error("Cannot map file chunk");
+#else
+        uint64_t aligned = offset - offset % uint64_t(sysconf(_SC_PAGESIZE));
+        viewBytes = size_t(offset - aligned) + len;
+        view = mmap(nullptr, viewBytes, PROT_READ, MAP_PRIVATE, fd, off_t(aligned));
+        if (view == MAP_FAILED) {
+            view = nullptr;
+            throw std::runtime_error("Cannot map file chunk");
+        }
+        madvise(view, viewBytes, MADV_SEQUENTIAL);
+#endif
+        data = static_cast<const uint8_t*>(view) + (offset - aligned);
+        offset += len;
+        return true;
     }
 };
 
-int main() {
+/*
+ * Builds the same root as MerkleTree(data, size, blockSize) without
+ * holding the data or the tree. Leaves are hashed one chunk at a time and
+ * pushed into a frontier of at most one pending left child per level, like
+ * carries in a binary counter. Memory is one chunk of leaf digests plus
+ * O(log n) frontier entries, independent of file size.
+ *
+ * Nodes are final as soon as they are produced, so the optional level
+ * file is written in place: each level's offset is known up front from the
+ * leaf count, and the right edge is filled in when the stream ends.
+ */
+class StreamingMerkleBuilder {
+private:
+    size_t blockSize;
+    size_t chunkBytes;
+    std::vector<Digest> pending;
+    std::vector<uint8_t> hasPending;
+    std::vector<uint64_t> widths, produced, levelOffset;
+    std::ofstream levelOut;
+
+    void write(size_t level, uint64_t index, const Digest* nodes, size_t count) {
+        if (!levelOut.is_open() || count == 0) return;
+        levelOut.seekp(std::streamoff(levelOffset[level] + index * sizeof(Digest)));
+        levelOut.write(reinterpret_cast<const char*>(nodes), std::streamsize(count * sizeof(Digest)));
+    }
+
+    // Feeds consecutive nodes of one level, carrying completed pairs upward.
+    void push(size_t level, std::vector<Digest> nodes) {
+        while (!nodes.empty()) {
+            write(level, produced[level], nodes.data(), nodes.size());
+            produced[level] += nodes.size();
+
+            std::vector<Digest> parents;
+            size_t i = 0;
+            if (hasPending[level]) {
+                parents.push_back(MerkleTree::nodeHash(pending[level], nodes[0]));
+                hasPending[level] = 0;
+                i = 1;
+            }
+            size_t pairs = (nodes.size() - i) / 2, first = parents.size();
+            parents.resize(first + pairs);
+            MerkleTree::nodeHashPairs(nodes.data() + i, pairs, parents.data() + first);
+            if ((nodes.size() - i) % 2) {
+                pending[level] = nodes.back();
+                hasPending[level] = 1;
+            }
+            nodes.swap(parents);
+            level++;
+        }
+    }
+
+    // Closes the right edge: an unpaired pending node is promoted, and one
+    // that meets the edge carried up from below is hashed with it.
+    Digest finish() {
+        size_t top = widths.size() - 1;
+        bool carrying = false;
+        Digest carry{};
+        for (size_t level = 0; level < top; level++) {
+            if (hasPending[level] && carrying) carry = MerkleTree::nodeHash(pending[level], carry);
+            else if (hasPending[level]) carry = pending[level];
+            carrying |= bool(hasPending[level]);
+            if (carrying) write(level + 1, widths[level + 1] - 1, &carry, 1);
+        }
+        return carrying ? carry : pending[top];
+    }
+
+public:
+    StreamingMerkleBuilder(size_t blockSize = 4096, size_t chunkBytes = size_t(64) << 20)
+        : blockSize(blockSize), chunkBytes(std::max<size_t>(1, chunkBytes / blockSize) * blockSize) {}
+
+    // Root of the file's blockSize-byte leaves; writes every level to
+    // levelPath as well unless it is empty.
+    Digest hashFile(const std::string& path, const std::string& levelPath = "") {
+        ChunkedFileReader reader(path, chunkBytes);
+        uint64_t leaves = (reader.size() + blockSize - 1) / blockSize;
+        widths = levelWidths(leaves);
+        pending.assign(widths.size(), Digest{});
+        hasPending.assign(widths.size(), 0);
+        produced.assign(widths.size(), 0);
+        levelOffset.assign(widths.size(), sizeof(LevelFileHeader));
+        for (size_t level = 1; level < widths.size(); level++)
+            levelOffset[level] = levelOffset[level - 1] + widths[level - 1] * sizeof(Digest);
+
+        if (!levelPath.empty()) {
+            levelOut.open(levelPath, std::ios::binary | std::ios::trunc);
+            if (!levelOut) throw std::runtime_error("Cannot write " + levelPath);
+            LevelFileHeader h{{'M', 'R', 'K', 'L', 'E', 'V', 'E', 'L'}, LEVEL_FILE_VERSION, INDEX_BYTE_ORDER,
+                              blockSize, leaves, uint32_t(widths.size()), 0};
+            levelOut.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        }
+
+        const uint8_t* data;
+        size_t len;
+        while (reader.next(data, len)) {
+            size_t full = len / blockSize, count = (len + blockSize - 1) / blockSize;
+            std::vector<Digest> digests(count);
+            MerkleTree::leafHashBlocks(data, blockSize, full, digests.data());
+            if (full < count) digests.back() = MerkleTree::leafHash(data + full * blockSize, len - full * blockSize);
+            push(0, std::move(digests));
+        }
+
+        Digest root = leaves == 0 ? MerkleTree().getMerkleRoot() : finish();
+        if (levelOut.is_open()) {
+            levelOut.close();
+            if (!levelOut) throw std::runtime_error("Failed writing " + levelPath);
+        }
+        return root;
+    }
+
+    // Heap held while streaming: one chunk of leaf digests and the frontier.
+    size_t workingSetBytes() const {
+        return (chunkBytes / blockSize) * sizeof(Digest) * 2 + pending.size() * (sizeof(Digest) + 1);
+    }
+};
+
+MerkleTree MerkleTree::fromLevelFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Cannot open " + path);
+    LevelFileHeader h;
+    in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    if (!in || std::memcmp(h.magic, "MRKLEVEL", 8) != 0)
+        throw std::runtime_error(path + " is not a Merkle level file");
+    if (h.version != LEVEL_FILE_VERSION || h.byteOrder != INDEX_BYTE_ORDER)
+        throw std::runtime_error(path + ": unsupported version or byte order");
+
+    std::vector<uint64_t> widths = levelWidths(h.leafCount);
+    if (widths.size() != h.levelCount) throw std::runtime_error(path + ": inconsistent level count");
+    MerkleTree tree;
+    tree.levels.assign(widths.size(), {});
+    for (size_t level = 0; level < widths.size(); level++) {
+        tree.levels[level].resize(widths[level]);
+        in.read(reinterpret_cast<char*>(tree.levels[level].data()), std::streamsize(widths[level] * sizeof(Digest)));
+    }
+    if (!in) throw std::runtime_error("Truncated level file " + path);
+    return tree;
+}
+
+// ---------- Benchmark: hashing throughput per SHA-256 engine ----------
+
+void benchmark(size_t bytes, size_t blockSize) {
+    std::vector<uint8_t> data(bytes);
+    std::mt19937_64 rng(42);
+    for (size_t i = 0; i + 8 <= bytes; i += 8) {
+        uint64_t v = rng();
+        std::memcpy(&data[i], &v, 8);
+    }
+
+    std::cout << "  " << (bytes >> 20) << " MiB in " << blockSize << "-byte leaves ("
+              << bytes / blockSize << " leaves, " << std::max(1u, std::thread::hardware_concurrency())
+              << " threads)\n";
+    Digest reference{};
+    bool first = true, agree = true;
+    for (Sha256::Backend b : {Sha256::Scalar, Sha256::Avx2x8, Sha256::ShaNi}) {
+        if (!Sha256::supported(b)) {
+            std::cout << "    " << std::setw(8) << std::left << Sha256::name(b) << " not supported on this CPU\n";
+            continue;
+        }
+        Sha256::setBackend(b);
+        auto t0 = std::chrono::steady_clock::now();
+        MerkleTree tree(data.data(), data.size(), blockSize);
+        double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        if (first) reference = tree.getMerkleRoot();
+        agree &= tree.getMerkleRoot() == reference;
+        first = false;
+        std::streamsize precision = std::cout.precision(2);
+        std::cout << "    " << std::setw(8) << std::left << Sha256::name(b) << std::right << std::fixed
+                  << double(bytes) / sec / 1e9 << " GB/s  root " << toHex(tree.getMerkleRoot(), 8) << "\n";
+        std::cout.unsetf(std::ios::fixed);
+        std::cout.precision(precision);
+    }
+    std::cout << "    roots agree: " << (agree ? "yes" : "NO") << "\n";
+    Sha256::setBackend(Sha256::supported(Sha256::ShaNi) ? Sha256::ShaNi
+                       : Sha256::supported(Sha256::Avx2x8) ? Sha256::Avx2x8 : Sha256::Scalar);
+}
+
+// ---------- Benchmark: incremental sync vs. rebuilding ----------
+
+void benchmarkSync(size_t n, size_t changes) {
+    std::mt19937 rng(5);
+    std::vector<std::string> blocks(n);
+    for (size_t i = 0; i < n; i++) blocks[i] = "record " + std::to_string(i) + std::string(48, char('a' + i % 26));
+
+    auto seconds = [](auto&& f) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    MerkleTree tree;
+    double build = seconds([&] { tree = MerkleTree(blocks); });
+
+    std::vector<size_t> scattered;
+    for (size_t i = 0; i < changes; i++) scattered.push_back(rng() % n);
+    double updates = seconds([&] {
+        for (size_t i : scattered) {
+            blocks[i] += "'";
+            tree.update(i, blocks[i]);
+        }
+    });
+    std::vector<std::string> added;
+    for (size_t i = 0; i < changes; i++) added.push_back("appended " + std::to_string(i));
+    double appends = seconds([&] {
+        for (const auto& b : added) tree.append(b);
+    });
+    blocks.insert(blocks.end(), added.begin(), added.end());
+    bool consistent = MerkleTree(blocks).getMerkleRoot() == tree.getMerkleRoot();
+
+    std::cout << "  " << n << " leaves: full build " << build * 1e3 << " ms\n"
+              << "    update():  " << updates * 1e6 / changes << " us each (" << changes << " scattered)\n"
+              << "    append():  " << appends * 1e6 / changes << " us each (" << changes << " blocks)\n"
+              << "    root matches a rebuild: " << (consistent ? "yes" : "NO") << "\n";
+
+    std::vector<size_t> clustered(changes);
+    size_t start = rng() % (tree.leafCount() - changes);
+    for (size_t i = 0; i < changes; i++) clustered[i] = start + i;
+    for (auto* set : {&scattered, &clustered}) {
+        size_t separate = 0;
+        for (size_t i : *set) separate += tree.generateProof(i).size();
+        std::vector<Digest> multi = tree.generateMultiProof(*set);
+        std::vector<std::pair<size_t, std::string>> leaves;
+        for (size_t i : *set) leaves.emplace_back(i, blocks[i]);
+        bool valid = MerkleTree::verifyMultiProof(leaves, multi, tree.getMerkleRoot(), tree.leafCount());
+        std::cout << "    " << (set == &scattered ? "scattered" : "clustered") << " multi-proof: " << multi.size()
+                  << " digests vs " << separate << " in separate proofs ("
+                  << multi.size() * sizeof(Digest) / 1024 << " KiB), " << (valid ? "valid" : "INVALID") << "\n";
+    }
+}
+
+// ---------- Benchmark: streaming a file vs. hashing it in memory ----------
+
+void benchmarkStreaming(size_t bytes, size_t blockSize) {
+    // Scratch files go to the system temp directory, not the working directory
+    const std::filesystem::path tmp = std::filesystem::temp_directory_path();
+    const std::string dataPath = (tmp / "merkle_stream.bin").string();
+    const std::string levelPath = (tmp / "merkle_stream.levels").string();
+    {
+        std::ofstream out(dataPath, std::ios::binary);
+        std::mt19937_64 rng(77);
+        std::vector<uint64_t> buffer(1 << 16);
+        for (size_t written = 0; written < bytes; written += buffer.size() * 8) {
+            for (auto& v : buffer) v = rng();
+            out.write(reinterpret_cast<const char*>(buffer.data()),
+                      std::streamsize(std::min(bytes - written, buffer.size() * 8)));
+        }
+    }
+
+    auto seconds = [](auto&& f) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    StreamingMerkleBuilder builder(blockSize, size_t(16) << 20);
+    Digest streamed{};
+    double streamSec = seconds([&] { streamed = builder.hashFile(dataPath, levelPath); });
+
+    Digest inMemory{};
+    double memorySec = seconds([&] {
+        std::ifstream in(dataPath, std::ios::binary);
+        std::vector<uint8_t> data(bytes);
+        in.read(reinterpret_cast<char*>(data.data()), std::streamsize(bytes));
+        inMemory = MerkleTree(data.data(), data.size(), blockSize).getMerkleRoot();
+    });
+
+    MerkleTree reloaded = MerkleTree::fromLevelFile(levelPath);
+    size_t probe = reloaded.leafCount() / 3;
+    std::string block(blockSize, '\0');
+    {
+        std::ifstream in(dataPath, std::ios::binary);
+        in.seekg(std::streamoff(probe * blockSize));
+        in.read(&block[0], std::streamsize(blockSize));
+    }
+    bool proofOk = MerkleTree::verifyProof(block, reloaded.generateProof(probe), streamed, probe,
+                                           reloaded.leafCount());
+
+    std::cout << "  " << (bytes >> 20) << " MiB file, " << blockSize << "-byte leaves\n"
+              << "    streaming:  " << double(bytes) / streamSec / 1e9 << " GB/s with "
+              << builder.workingSetBytes() / 1024 << " KiB working set (+ level file)\n"
+              << "    in memory:  " << double(bytes) / memorySec / 1e9 << " GB/s holding all "
+              << (bytes >> 20) << " MiB\n"
+              << "    roots agree: " << (streamed == inMemory && reloaded.getMerkleRoot() == streamed ? "yes" : "NO")
+              << ", proof from level file: " << (proofOk ? "Valid" : "Invalid") << "\n";
+    std::remove(dataPath.c_str());
+    std::remove(levelPath.c_str());
+}
+
+int main(int argc, char** argv) {
     std::vector<std::string> blocks = {"Alice pays Bob", "Bob pays Carol", "Carol pays Dave", "Dave pays Eve"};
 
+    std::cout << "SHA-256 engine: " << Sha256::name(Sha256::backend()) << ", SHA-256(\"abc\") = "
+              << toHex(Sha256::hash((const uint8_t*)"abc", 3)) << "\n\n";
+
     MerkleTree tree(blocks);
     tree.printTree();
 
-    std::string root = tree.getMerkleRoot();
-    std::cout << "\nMerkle Root: " << root << "\n\n";
+    Digest root = tree.getMerkleRoot();
+    std::cout << "\nMerkle Root: " << toHex(root) << "\n\n";
 
     // Example Merkle proof
     size_t index = 1; // Bob pays Carol
     std::string data = blocks[index];
-    std::vector<std::string> proof = tree.generateProof(index);
+    std::vector<Digest> proof = tree.generateProof(index);
 
     std::cout << "Merkle Proof for block \"" << data << "\" at index " << index << ":\n";
     for (const auto& h : proof)
-        std::cout << "- [" << h.substr(0, 8) << "]\n";
+        std::cout << "- [" << toHex(h, 4) << "]\n";
 
-    bool valid = tree.verifyProof(data, proof, root, index);
+    bool valid = MerkleTree::verifyProof(data, proof, root, index, tree.leafCount());
     std::cout << "\nVerification result: " << (valid ? "Valid" : "Invalid") << "\n";
+    bool forged = MerkleTree::verifyProof("Bob pays Mallory", proof, root, index, tree.leafCount());
+    std::cout << "Tampered block \"Bob pays Mallory\": " << (forged ? "Valid" : "Invalid") << "\n";
+
+    // Incremental maintenance: only the changed path is rehashed.
+    tree.update(2, "Carol pays Frank");
+    tree.append("Eve pays Alice");
+    std::cout << "\nAfter update(2) and append(): root " << toHex(tree.getMerkleRoot(), 8) << "..., "
+              << tree.leafCount() << " leaves\n";
+    std::vector<Digest> multi = tree.generateMultiProof({0, 1, 4});
+    bool multiValid = MerkleTree::verifyMultiProof(
+        {{0, "Alice pays Bob"}, {1, "Bob pays Carol"}, {4, "Eve pays Alice"}}, multi, tree.getMerkleRoot(),
+        tree.leafCount());
+    std::cout << "Multi-proof for leaves {0, 1, 4}: " << multi.size() << " digests, "
+              << (multiValid ? "Valid" : "Invalid") << "\n";
 
     std::cout << "\n--- Merkle Tree Strengths ---\n";
     std::cout << "1. Efficient integrity verification (log(N) proof size).\n";
@@ -113,5 +1026,14 @@ int main() {
     std::cout << "3. Secure against tampering (any change alters root).\n";
     std::cout << "4. Used in Bitcoin, Git, IPFS, blockchains.\n";
 
+    // Usage: 06-merkle_tree --benchmark
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        std::cout << "\n--- Benchmark ---\n";
+        benchmark(size_t(256) << 20, 4096);
+        benchmark(size_t(64) << 20, 64);
+        benchmarkSync(size_t(1) << 20, 1000);
+        benchmarkStreaming(size_t(512) << 20, 4096);
+    }
+
     return 0;
 }
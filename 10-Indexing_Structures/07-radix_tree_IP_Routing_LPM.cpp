@@ -0,0 +1,397 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+/*
+ * =====================================================================
+ *  Program: Longest-Prefix-Match IP Routing with a Bitwise Patricia Trie
+ *
+ *  Description:
+ *  ------------
+ *  A router forwards each packet along the most specific route whose
+ *  CIDR prefix contains the destination address. The string-keyed radix
+ *  tree in 02-radix_tree.cpp branches on bytes; routing prefixes end at
+ *  arbitrary bit positions, so this trie branches on single bits instead
+ *  and works directly on uint32_t (IPv4) and __uint128_t (IPv6) keys.
+ *
+ *  Layout:
+ *    - Path compression: a node stores its full prefix and length, and
+ *      one-child chains are skipped entirely (Patricia).
+ *    - Nodes sit in one flat vector addressed by 32-bit indices. bulkLoad()
+ *      builds them in pre-order from a sorted table, so the 0-child is
+ *      usually the next node in memory.
+ *    - A 2^20-entry (8 MiB) stride table resolves the first 20 bits in
+ *      one load: it records the best route shorter than 20 bits and the
+ *      node where the walk continues, so a lookup in a full table only
+ *      touches one or two trie nodes.
+ *    - lpmBatch() interleaves 16 lookups with software prefetch to overlap
+ *      their cache misses.
+ * =====================================================================
+ */
+
+template <typename Addr>
+class PatriciaTrie {
+public:
+    static constexpr int BITS = int(sizeof(Addr) * 8);
+    static constexpr uint32_t NO_ROUTE = UINT32_MAX;
+
+    struct Route {
+        Addr prefix;
+        int length;
+        uint32_t nextHop;
+    };
+
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr int STRIDE = 20;
+
+    struct Node {
+        Addr key;            // prefix bits, zero past len
+        uint32_t child[2];
+        uint32_t nextHop;    // NO_ROUTE if the node only branches
+        uint8_t len;
+    };
+
+    struct StrideEntry {
+        uint32_t node;       // where the walk continues, NIL if nothing deeper
+        uint32_t nextHop;    // best route with length <= STRIDE
+    };
+
+    std::vector<Node> nodes;
+    uint32_t root = NIL;
+    std::vector<StrideEntry> strideTable; // empty until built
+
+    static Addr mask(int len) { return len == 0 ? Addr(0) : Addr(~Addr(0)) << (BITS - len); }
+    static int bitAt(Addr a, int i) { return int((a >> (BITS - 1 - i)) & 1); }
+    static bool matches(Addr a, const Node& n) { return ((a ^ n.key) & mask(n.len)) == 0; }
+
+    static int commonPrefix(Addr a, Addr b, int limit) {
+        Addr diff = a ^ b;
+        int c = 0;
+        while (c < limit && !((diff >> (BITS - 1 - c)) & 1)) ++c;
+        return c;
+    }
+
+    uint32_t newNode(Addr key, int len, uint32_t nextHop) {
+        nodes.push_back({key, {NIL, NIL}, nextHop, uint8_t(len)});
+        return uint32_t(nodes.size() - 1);
+    }
+
+    // routes[lo, hi) are sorted and all share their first `depth` bits
+    uint32_t build(const std::vector<Route>& routes, size_t lo, size_t hi, int depth) {
+        if (lo == hi) return NIL;
+        int len = commonPrefix(routes[lo].prefix, routes[hi - 1].prefix, BITS);
+        for (size_t i = lo; i < hi; ++i) len = std::min(len, routes[i].length);
+        len = std::max(len, depth);
+
+        uint32_t hop = NO_ROUTE;
+        if (routes[lo].length == len) hop = routes[lo++].nextHop; // sorts first among its peers
+        uint32_t id = newNode(routes[lo == hi ? lo - 1 : lo].prefix & mask(len), len, hop);
+
+        size_t split = size_t(std::partition_point(routes.begin() + lo, routes.begin() + hi,
+                                                   [&](const Route& r) { return bitAt(r.prefix, len) == 0; }) -
+                              routes.begin());
+        uint32_t zero = build(routes, lo, split, len + 1);
+        uint32_t one = build(routes, split, hi, len + 1);
+        nodes[id].child[0] = zero;
+        nodes[id].child[1] = one;
+        return id;
+    }
+
+    // Stride table: for each value of the first STRIDE bits, walk the trie
+    // through every node that ends before bit STRIDE; the node after that
+    // depends on lower address bits, so the lookup resumes there
+    void buildStrideTable() {
+        strideTable.assign(size_t(1) << STRIDE, {NIL, NO_ROUTE});
+        for (size_t v = 0; v < strideTable.size(); ++v) {
+            Addr a = Addr(v) << (BITS - STRIDE);
+            uint32_t best = NO_ROUTE, i = root;
+            while (i != NIL && nodes[i].len < STRIDE) {
+                const Node& n = nodes[i];
+                if (!matches(a, n)) { i = NIL; break; }
+                if (n.nextHop != NO_ROUTE) best = n.nextHop;
+                i = n.child[bitAt(a, n.len)];
+            }
+            strideTable[v] = {i, best};
+        }
+    }
+
+public:
+    // Replaces the table with routes; duplicates keep the last next hop
+    void bulkLoad(std::vector<Route> routes) {
+        for (auto& r : routes) r.prefix &= mask(r.length);
+        std::stable_sort(routes.begin(), routes.end(), [](const Route& a, const Route& b) {
+            return a.prefix != b.prefix ? a.prefix < b.prefix : a.length < b.length;
+        });
+        std::vector<Route> unique;
+        for (const auto& r : routes) {
+            if (!unique.empty() && unique.back().prefix == r.prefix && unique.back().length == r.length)
+                unique.back() = r;
+            else
+                unique.push_back(r);
+        }
+
+        nodes.clear();
+        nodes.reserve(2 * unique.size());
+        root = build(unique, 0, unique.size(), 0);
+        buildStrideTable();
+    }
+
+    // Single-route insert; drops the stride table until the next bulkLoad()
+    void insert(Addr prefix, int length, uint32_t nextHop) {
+        strideTable.clear();
+        prefix &= mask(length);
+        uint32_t parent = NIL;
+        int side = 0;
+        uint32_t i = root;
+
+        while (true) {
+            if (i == NIL) {
+                uint32_t leaf = newNode(prefix, length, nextHop);
+                (parent == NIL ? root : nodes[parent].child[side]) = leaf;
+                return;
+            }
+            int nodeLen = nodes[i].len;
+            int c = commonPrefix(prefix, nodes[i].key, std::min(length, nodeLen));
+            if (c == nodeLen && c == length) {
+                nodes[i].nextHop = nextHop;
+                return;
+            }
+            if (c == nodeLen) {
+                parent = i;
+                side = bitAt(prefix, nodeLen);
+                i = nodes[i].child[side];
+                continue;
+            }
+
+            // The new prefix diverges inside node i's path: put a node at c
+            uint32_t mid;
+            if (c == length) {
+                mid = newNode(prefix, length, nextHop);
+                nodes[mid].child[bitAt(nodes[i].key, c)] = i;
+            } else {
+                mid = newNode(prefix & mask(c), c, NO_ROUTE);
+                uint32_t leaf = newNode(prefix, length, nextHop);
+                nodes[mid].child[bitAt(nodes[i].key, c)] = i;
+                nodes[mid].child[bitAt(prefix, c)] = leaf;
+            }
+            (parent == NIL ? root : nodes[parent].child[side]) = mid;
+            return;
+        }
+    }
+
+    // Next hop of the longest prefix containing addr, or NO_ROUTE
+    uint32_t lpm(Addr addr) const {
+        uint32_t best = NO_ROUTE, i = root;
+        if (!strideTable.empty()) {
+            const StrideEntry& e = strideTable[size_t(addr >> (BITS - STRIDE))];
+            best = e.nextHop;
+            i = e.node;
+        }
+        while (i != NIL) {
+            const Node& n = nodes[i];
+            if (!matches(addr, n)) break;
+            if (n.nextHop != NO_ROUTE) best = n.nextHop;
+            if (n.len == BITS) break;
+            i = n.child[bitAt(addr, n.len)];
+        }
+        return best;
+    }
+
+    // Resolves many addresses at once. LANES lookups walk the trie in
+    // lockstep and each prefetches its next node, so the cache misses of
+    // different lookups overlap instead of queueing one after another.
+    void lpmBatch(const Addr* addrs, size_t count, uint32_t* out) const {
+        constexpr size_t LANES = 16;
+        for (size_t base = 0; base < count; base += LANES) {
+            size_t lanes = std::min(LANES, count - base);
+            uint32_t node[LANES], best[LANES];
+            if (!strideTable.empty())
+                for (size_t l = 0; l < lanes; ++l)
+                    __builtin_prefetch(&strideTable[size_t(addrs[base + l] >> (BITS - STRIDE))]);
+            for (size_t l = 0; l < lanes; ++l) {
+                best[l] = NO_ROUTE;
+                node[l] = root;
+                if (!strideTable.empty()) {
+                    const StrideEntry& e = strideTable[size_t(addrs[base + l] >> (BITS - STRIDE))];
+                    best[l] = e.nextHop;
+                    node[l] = e.node;
+                }
+                if (node[l] != NIL) __builtin_prefetch(&nodes[node[l]]);
+            }
+            for (bool active = true; active;) {
+                active = false;
+                for (size_t l = 0; l < lanes; ++l) {
+                    if (node[l] == NIL) continue;
+                    const Node& n = nodes[node[l]];
+                    Addr addr = addrs[base + l];
+                    if (!matches(addr, n)) { node[l] = NIL; continue; }
+                    if (n.nextHop != NO_ROUTE) best[l] = n.nextHop;
+                    node[l] = n.len == BITS ? NIL : n.child[bitAt(addr, n.len)];
+                    if (node[l] != NIL) {
+                        __builtin_prefetch(&nodes[node[l]]);
+                        active = true;
+                    }
+                }
+            }
+            for (size_t l = 0; l < lanes; ++l) out[base + l] = best[l];
+        }
+    }
+
+    size_t nodeCount() const { return nodes.size(); }
+    size_t bytes() const { return nodes.size() * sizeof(Node) + strideTable.size() * sizeof(StrideEntry); }
+};
+
+using Ipv4Table = PatriciaTrie<uint32_t>;
+using Ipv6Table = PatriciaTrie<__uint128_t>;
+
+// ---------- Address parsing and printing ----------
+
+uint32_t parseIpv4(const std::string& s) {
+    uint32_t a = 0;
+    std::stringstream ss(s);
+    std::string part;
+    while (std::getline(ss, part, '.')) a = a << 8 | uint32_t(std::stoul(part));
+    return a;
+}
+
+__uint128_t parseIpv6(const std::string& s) {
+    auto groups = [](const std::string& t) {
+        std::vector<uint16_t> g;
+        std::stringstream ss(t);
+        std::string part;
+        while (std::getline(ss, part, ':'))
+            if (!part.empty()) g.push_back(uint16_t(std::stoul(part, nullptr, 16)));
+        return g;
+    };
+    size_t gap = s.find("::");
+    std::vector<uint16_t> head = groups(s.substr(0, gap));
+    std::vector<uint16_t> tail = gap == std::string::npos ? std::vector<uint16_t>() : groups(s.substr(gap + 2));
+    head.resize(8 - tail.size(), 0);
+    head.insert(head.end(), tail.begin(), tail.end());
+
+    __uint128_t a = 0;
+    for (uint16_t g : head) a = a << 16 | g;
+    return a;
+}
+
+// "a.b.c.d/len" or "x:y::z/len"
+template <typename Table, typename Parse>
+void addRoute(Table& table, const std::string& cidr, uint32_t nextHop, Parse parse) {
+    size_t slash = cidr.find('/');
+    table.insert(parse(cidr.substr(0, slash)), std::stoi(cidr.substr(slash + 1)), nextHop);
+}
+
+// ---------- Benchmark ----------
+
+// Length mix loosely following a full IPv4 BGP table: mostly /24, then /22-/23, then shorter
+int randomIpv4Length(std::mt19937& rng) {
+    int r = int(rng() % 100);
+    if (r < 58) return 24;
+    if (r < 78) return 22 + int(rng() % 2);
+    if (r < 96) return 16 + int(rng() % 6);
+    return 8 + int(rng() % 8);
+}
+
+template <typename Addr, typename RandomAddr, typename RandomLength>
+void benchmark(const std::string& name, size_t numRoutes, RandomAddr randomAddr, RandomLength randomLength,
+               std::mt19937& rng) {
+    using Table = PatriciaTrie<Addr>;
+    std::vector<typename Table::Route> routes(numRoutes);
+    for (size_t i = 0; i < numRoutes; ++i)
+        routes[i] = {randomAddr(), randomLength(), uint32_t(i)};
+
+    Table table;
+    auto t0 = std::chrono::steady_clock::now();
+    table.bulkLoad(routes);
+    auto t1 = std::chrono::steady_clock::now();
+
+    // Half of the lookups fall inside a known route, half are random
+    const size_t numLookups = 10000000;
+    std::vector<Addr> addrs(numLookups);
+    for (size_t i = 0; i < numLookups; ++i) {
+        const auto& r = routes[rng() % numRoutes];
+        Addr host = randomAddr();
+        addrs[i] = (i % 2) ? host : Addr(r.prefix | (host >> r.length)); // lengths stay below BITS
+    }
+
+    uint64_t checksum = 0, batchChecksum = 0;
+    auto t2 = std::chrono::steady_clock::now();
+    for (Addr a : addrs) checksum += table.lpm(a);
+    auto t3 = std::chrono::steady_clock::now();
+    std::vector<uint32_t> hops(numLookups);
+    table.lpmBatch(addrs.data(), numLookups, hops.data());
+    auto t4 = std::chrono::steady_clock::now();
+    for (uint32_t h : hops) batchChecksum += h;
+
+    // Cross-check a sample against a per-length hash map scan
+    std::vector<std::unordered_map<uint64_t, uint32_t>> byLength(Table::BITS + 1);
+    auto hashKey = [](Addr a) { return uint64_t(a) ^ uint64_t(__uint128_t(a) >> 64) * 0x9E3779B97F4A7C15ull; };
+    for (const auto& r : routes) {
+        Addr p = r.length == 0 ? Addr(0) : r.prefix & (Addr(~Addr(0)) << (Table::BITS - r.length));
+        byLength[r.length][hashKey(p)] = r.nextHop;
+    }
+    size_t mismatches = 0;
+    for (size_t i = 0; i < 20000; ++i) {
+        Addr a = addrs[i];
+        uint32_t expected = Table::NO_ROUTE;
+        for (int len = Table::BITS; len >= 0; --len) {
+            Addr p = len == 0 ? Addr(0) : a & (Addr(~Addr(0)) << (Table::BITS - len));
+            auto it = byLength[len].find(hashKey(p));
+            if (it != byLength[len].end()) { expected = it->second; break; }
+        }
+        mismatches += table.lpm(a) != expected;
+    }
+
+    auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+    std::cout << "  " << name << ": " << numRoutes << " prefixes, " << table.nodeCount() << " nodes, "
+              << double(table.bytes()) / (1 << 20) << " MiB\n"
+              << "    bulk load: " << ms(t0, t1) << " ms\n"
+              << "    lpm():      " << double(numLookups) / ms(t2, t3) / 1000.0 << " M lookups/s\n"
+              << "    lpmBatch(): " << double(numLookups) / ms(t3, t4) / 1000.0 << " M lookups/s"
+              << (checksum == batchChecksum ? "" : " (RESULTS DIFFER)") << "\n"
+              << "    sample check against brute force: " << (mismatches == 0 ? "ok" : "MISMATCH") << "\n";
+}
+
+int main() {
+    Ipv4Table v4;
+    addRoute(v4, "0.0.0.0/0", 1, parseIpv4);        // default route
+    addRoute(v4, "10.0.0.0/8", 2, parseIpv4);
+    addRoute(v4, "10.1.0.0/16", 3, parseIpv4);
+    addRoute(v4, "10.1.2.0/24", 4, parseIpv4);
+    addRoute(v4, "192.168.0.0/16", 5, parseIpv4);
+
+    std::cout << "IPv4 routing table:\n";
+    for (const std::string ip : {"10.1.2.3", "10.1.9.9", "10.200.0.1", "192.168.1.1", "8.8.8.8"})
+        std::cout << "  " << ip << " -> next hop " << v4.lpm(parseIpv4(ip)) << "\n";
+
+    Ipv6Table v6;
+    addRoute(v6, "2001:db8::/32", 1, parseIpv6);
+    addRoute(v6, "2001:db8:abcd::/48", 2, parseIpv6);
+    addRoute(v6, "2001:db8:abcd:12::/64", 3, parseIpv6);
+
+    std::cout << "\nIPv6 routing table:\n";
+    for (const std::string ip : {"2001:db8:abcd:12::1", "2001:db8:abcd:ff::1", "2001:db8:1::1", "2a00::1"}) {
+        uint32_t hop = v6.lpm(parseIpv6(ip));
+        std::cout << "  " << ip << " -> ";
+        if (hop == Ipv6Table::NO_ROUTE) std::cout << "no route\n";
+        else std::cout << "next hop " << hop << "\n";
+    }
+
+    std::cout << "\n--- Lookup Benchmark ---\n";
+    std::mt19937 rng(2024);
+    std::mt19937_64 rng64(2024);
+    benchmark<uint32_t>("IPv4", 1000000, [&] { return uint32_t(rng()); }, [&] { return randomIpv4Length(rng); }, rng);
+    benchmark<__uint128_t>(
+        "IPv6", 200000,
+        [&] { return (__uint128_t(0x2000 | (rng64() & 0x1FFF)) << 112) | (__uint128_t(rng64() & 0xFFFFFFFFFFFFull) << 64) | rng64(); },
+        [&] { return 32 + int(rng() % 17); }, rng);
+
+    return 0;
+}
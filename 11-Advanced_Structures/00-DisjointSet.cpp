@@ -1,5 +1,15 @@
 #include <iostream>
 #include <vector>
+#include <atomic>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
 using namespace std;
 
 class DisjointSet {
@@ -11,10 +21,17 @@ public:
         for (int i = 0; i < n; ++i) parent[i] = i;
     }
 
+    // Iterative: one pass to the root, a second to point every node on the
+    // path straight at it. No recursion, so no call overhead or stack depth.
     int find(int u) {
-        if (u != parent[u])
-            parent[u] = find(parent[u]); // Path compression
-        return parent[u];
+        int root = u;
+        while (root != parent[root]) root = parent[root];
+        while (u != root) { // Path compression
+            int next = parent[u];
+            parent[u] = root;
+            u = next;
+        }
+        return root;
     }
 
     void unite(int u, int v) {
@@ -34,7 +51,339 @@ public:
     }
 };
 
-int main() {
+/*
+ * Lock-free union-find that any number of threads may use at once.
+ *
+ * Roots are linked by index: the root with the smaller index is CAS'd
+ * under the larger one. Every parent pointer therefore only ever points
+ * to a higher index, so a find climbs a strictly increasing sequence and
+ * finishes in a bounded number of steps whatever other threads do
+ * (wait-free). Path splitting shortens paths on the way up: each visited
+ * node is CAS'd to its grandparent, and a lost race is simply ignored
+ * because the pointer still leads to the same root.
+ *
+ * A unite whose CAS fails means another thread just linked that root;
+ * it re-finds both roots and tries again.
+ */
+class ConcurrentDisjointSet {
+    unique_ptr<atomic<uint32_t>[]> parent;
+    uint32_t n;
+public:
+    ConcurrentDisjointSet(uint32_t n) : parent(new atomic<uint32_t>[n]), n(n) {
+        for (uint32_t i = 0; i < n; ++i) parent[i].store(i, memory_order_relaxed);
+    }
+
+    uint32_t size() const { return n; }
+
+    uint32_t find(uint32_t u) {
+        while (true) {
+            uint32_t p = parent[u].load(memory_order_relaxed);
+            if (p == u) return u;
+            uint32_t gp = parent[p].load(memory_order_relaxed);
+            if (p != gp) parent[u].compare_exchange_weak(p, gp, memory_order_relaxed); // path splitting
+            u = p;
+        }
+    }
+
+    // Returns true if this call merged two different sets.
+    bool unite(uint32_t u, uint32_t v) {
+        while (true) {
+            u = find(u);
+            v = find(v);
+            if (u == v) return false;
+            if (u < v) swap(u, v);
+            uint32_t expected = v;
+            if (parent[v].compare_exchange_strong(expected, u, memory_order_acq_rel)) return true;
+        }
+    }
+
+    bool connected(uint32_t u, uint32_t v) {
+        while (true) {
+            u = find(u);
+            v = find(v);
+            if (u == v) return true;
+            // u was a root when found; if it still is, the sets really differ.
+            if (parent[u].load(memory_order_acquire) == u) return false;
+        }
+    }
+};
+
+/*
+ * Union by rank without path compression, so every union can be undone.
+ * Each successful unite() pushes one record; rollback() pops records back
+ * to an earlier snapshot(). Rank keeps trees O(log n) deep, which bounds
+ * find() at O(log n) instead of the amortized α(n) of the compressed set.
+ */
+class RollbackDisjointSet {
+    struct Record {
+        int child;      // root that was linked under another
+        bool rankGrew;  // whether the new root's rank was bumped
+    };
+
+    vector<int> parent, rank;
+    vector<Record> history;
+    int components;
+public:
+    RollbackDisjointSet(int n) : parent(n), rank(n, 0), components(n) {
+        for (int i = 0; i < n; ++i) parent[i] = i;
+    }
+
+    int find(int u) const {
+        while (u != parent[u]) u = parent[u];
+        return u;
+    }
+
+    bool unite(int u, int v) {
+        int pu = find(u), pv = find(v);
+        if (pu == pv) return false;
+        if (rank[pu] < rank[pv]) swap(pu, pv);
+        bool grew = rank[pu] == rank[pv];
+        parent[pv] = pu;
+        if (grew) rank[pu]++;
+        history.push_back({pv, grew});
+        components--;
+        return true;
+    }
+
+    bool connected(int u, int v) const { return find(u) == find(v); }
+    int componentCount() const { return components; }
+
+    size_t snapshot() const { return history.size(); }
+
+    // Undoes every union made after the snapshot, newest first.
+    void rollback(size_t snap) {
+        while (history.size() > snap) {
+            Record r = history.back();
+            history.pop_back();
+            int root = parent[r.child];
+            if (r.rankGrew) rank[root]--;
+            parent[r.child] = r.child;
+            components++;
+        }
+    }
+};
+
+/*
+ * Offline dynamic connectivity: replays a log of edge insertions,
+ * deletions and queries, and answers every query in one pass.
+ *
+ * Each edge is alive over an interval of query indices. That interval is
+ * stored in the O(log Q) segment-tree nodes covering it. A DFS over the
+ * tree unites a node's edges on entry and rolls them back on exit. At each
+ * leaf the set holds exactly the edges alive at that query. Total cost is
+ * O((E log Q + Q) log n), with no rebuilding between windows.
+ */
+class OfflineDynamicConnectivity {
+    struct Query {
+        int u, v;  // u == -1 asks for the component count
+    };
+
+    int n;
+    vector<Query> queries;
+    unordered_map<uint64_t, vector<int>> open;  // edge -> query indices at which live copies began
+    vector<pair<pair<int, int>, pair<int, int>>> intervals;  // edge, [from, to) in query indices
+    vector<vector<pair<int, int>>> tree;
+
+    static uint64_t key(int u, int v) {
+        if (u > v) swap(u, v);
+        return uint64_t(uint32_t(u)) << 32 | uint32_t(v);
+    }
+
+    static pair<int, int> endpoints(uint64_t k) { return {int(k >> 32), int(uint32_t(k))}; }
+
+    void place(int node, int lo, int hi, int from, int to, pair<int, int> edge) {
+        if (to <= lo || hi <= from) return;
+        if (from <= lo && hi <= to) {
+            tree[node].push_back(edge);
+            return;
+        }
+        int mid = (lo + hi) / 2;
+        place(2 * node, lo, mid, from, to, edge);
+        place(2 * node + 1, mid, hi, from, to, edge);
+    }
+
+    void dfs(int node, int lo, int hi, RollbackDisjointSet& ds, vector<int>& answers) {
+        size_t snap = ds.snapshot();
+        for (auto& e : tree[node]) ds.unite(e.first, e.second);
+        if (hi - lo == 1) {
+            const Query& q = queries[lo];
+            answers[lo] = q.u < 0 ? ds.componentCount() : ds.connected(q.u, q.v);
+        } else {
+            int mid = (lo + hi) / 2;
+            dfs(2 * node, lo, mid, ds, answers);
+            dfs(2 * node + 1, mid, hi, ds, answers);
+        }
+        ds.rollback(snap);
+    }
+
+public:
+    OfflineDynamicConnectivity(int n) : n(n) {}
+
+    void addEdge(int u, int v) { open[key(u, v)].push_back(int(queries.size())); }
+
+    void removeEdge(int u, int v) {
+        auto it = open.find(key(u, v));
+        if (it == open.end() || it->second.empty()) return;
+        intervals.push_back({endpoints(it->first), {it->second.back(), int(queries.size())}});
+        it->second.pop_back();
+        if (it->second.empty()) open.erase(it);
+    }
+
+    void queryComponents() { queries.push_back({-1, -1}); }
+    void queryConnected(int u, int v) { queries.push_back({u, v}); }
+
+    // Answers in query order: a component count, or 1/0 for connected.
+    vector<int> solve() {
+        int q = int(queries.size());
+        vector<int> answers(q);
+        if (q == 0) return answers;
+        for (auto& [edge, starts] : open)
+            for (int from : starts) intervals.push_back({endpoints(edge), {from, q}});
+        open.clear();
+
+        tree.assign(4 * q, {});
+        for (auto& [edge, span] : intervals)
+            if (span.first < span.second) place(1, 0, q, span.first, span.second, edge);
+        RollbackDisjointSet ds(n);
+        dfs(1, 0, q, ds, answers);
+        return answers;
+    }
+};
+
+struct Edge {
+    uint32_t u, v;
+};
+
+// Unites every edge using `threads` workers on contiguous slices of the
+// edge list, then counts the resulting components in parallel.
+size_t parallelConnectedComponents(ConcurrentDisjointSet& ds, const vector<Edge>& edges, unsigned threads) {
+    vector<thread> pool;
+    size_t per = (edges.size() + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        size_t begin = min(edges.size(), t * per), end = min(edges.size(), begin + per);
+        pool.emplace_back([&ds, &edges, begin, end] {
+            for (size_t i = begin; i < end; ++i) ds.unite(edges[i].u, edges[i].v);
+        });
+    }
+    for (auto& th : pool) th.join();
+    pool.clear();
+
+    vector<size_t> roots(threads, 0);
+    uint32_t chunk = (ds.size() + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&ds, &roots, t, chunk] {
+            uint32_t begin = min(ds.size(), t * chunk), end = min(ds.size(), begin + chunk);
+            for (uint32_t i = begin; i < end; ++i) roots[t] += ds.find(i) == i;
+        });
+    }
+    for (auto& th : pool) th.join();
+    size_t components = 0;
+    for (size_t r : roots) components += r;
+    return components;
+}
+
+// ---------- Benchmark: sequential vs. concurrent connected components ----------
+
+// Community-structured random graph: most edges stay inside blocks of
+// 4096 vertices, 2% jump anywhere, leaving some vertices isolated.
+vector<Edge> makeGraph(uint32_t n, size_t m) {
+    vector<Edge> edges(m);
+    mt19937_64 rng(2024);
+    for (auto& e : edges) {
+        uint64_t r = rng();
+        uint32_t u = uint32_t(r % n);
+        uint32_t v = (r >> 32) % 100 < 2 ? uint32_t(rng() % n)
+                                         : min(n - 1, (u & ~4095u) + uint32_t(rng() % 4096));
+        e = {u, v};
+    }
+    return edges;
+}
+
+void benchmark(uint32_t n, size_t m) {
+    auto seconds = [](auto&& f) {
+        auto t0 = chrono::steady_clock::now();
+        f();
+        return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    };
+
+    vector<Edge> edges;
+    double gen = seconds([&] { edges = makeGraph(n, m); });
+    cout << "  " << n << " vertices, " << m << " edges (generated in " << gen << " s)\n";
+
+    size_t seqComponents = 0;
+    double seq = seconds([&] {
+        DisjointSet ds(static_cast<int>(n));
+        for (const Edge& e : edges) ds.unite(int(e.u), int(e.v));
+        for (uint32_t i = 0; i < n; ++i) seqComponents += ds.find(int(i)) == int(i);
+    });
+    cout << "    sequential:              " << seq << " s, " << m / seq / 1e6 << " M edges/s, "
+         << seqComponents << " components\n";
+
+    unsigned hw = max(1u, thread::hardware_concurrency());
+    for (unsigned t = 1; t <= max(hw, 4u); t *= 2) {
+        size_t components = 0;
+        double par = seconds([&] {
+            ConcurrentDisjointSet ds(n);
+            components = parallelConnectedComponents(ds, edges, t);
+        });
+        cout << "    concurrent, " << t << " thread(s): " << par << " s, " << m / par / 1e6 << " M edges/s, " << components << " components"
+             << (components == seqComponents ? "" : "  MISMATCH") << "\n";
+    }
+    cout << "    (" << hw << " hardware thread" << (hw > 1 ? "s" : "") << " available)\n";
+}
+
+// ---------- Benchmark: offline dynamic connectivity vs. rebuild per window ----------
+
+// A sliding window over an edge stream: each step inserts one edge and
+// retires the oldest, and every `stride` steps asks for the component count.
+void benchmarkWindows(int n, size_t steps, size_t window, size_t stride) {
+    auto seconds = [](auto&& f) {
+        auto t0 = chrono::steady_clock::now();
+        f();
+        return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    };
+
+    mt19937 rng(99);
+    vector<Edge> stream(steps);
+    for (auto& e : stream) e = {uint32_t(rng() % n), uint32_t(rng() % n)};
+
+    vector<int> offline;
+    double offlineSec = seconds([&] {
+        OfflineDynamicConnectivity dc(n);
+        for (size_t i = 0; i < steps; ++i) {
+            dc.addEdge(int(stream[i].u), int(stream[i].v));
+            if (i >= window) dc.removeEdge(int(stream[i - window].u), int(stream[i - window].v));
+            if ((i + 1) % stride == 0) dc.queryComponents();
+        }
+        offline = dc.solve();
+    });
+
+    vector<int> rebuilt;
+    double rebuildSec = seconds([&] {
+        for (size_t i = 0; i < steps; ++i) {
+            if ((i + 1) % stride) continue;
+            DisjointSet ds(n);
+            int components = n;
+            size_t first = i + 1 > window ? i + 1 - window : 0;
+            for (size_t j = first; j <= i; ++j) {
+                int pu = ds.find(int(stream[j].u)), pv = ds.find(int(stream[j].v));
+                if (pu != pv) {
+                    ds.unite(pu, pv);
+                    components--;
+                }
+            }
+            rebuilt.push_back(components);
+        }
+    });
+
+    cout << "  " << n << " vertices, " << steps << " edge events, window " << window << ", "
+         << rebuilt.size() << " queries\n"
+         << "    offline (segment tree + rollback): " << offlineSec << " s\n"
+         << "    rebuild per window:                " << rebuildSec << " s\n"
+         << "    answers agree: " << (offline == rebuilt ? "yes" : "NO") << "\n";
+}
+
+int main(int argc, char** argv) {
     DisjointSet ds(10);
     ds.unite(1, 2);
     ds.unite(3, 4);
@@ -44,4 +393,25 @@ int main() {
     ds.unite(5, 7);
     ds.unite(1, 5);
     ds.printSets(10);
+
+    // Union-find with undo: try a union, then take it back.
+    RollbackDisjointSet rds(5);
+    rds.unite(0, 1);
+    size_t snap = rds.snapshot();
+    rds.unite(1, 2);
+    rds.unite(3, 4);
+    cout << "\nRollback set: " << rds.componentCount() << " components, 0~2 "
+         << (rds.connected(0, 2) ? "connected" : "apart");
+    rds.rollback(snap);
+    cout << "; after rollback: " << rds.componentCount() << " components, 0~2 "
+         << (rds.connected(0, 2) ? "connected" : "apart") << '\n';
+
+    // Usage: 00-DisjointSet --benchmark [edges] [vertices]
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        size_t m = argc > 2 ? strtoull(argv[2], nullptr, 10) : 100000000;
+        uint32_t n = argc > 3 ? uint32_t(strtoul(argv[3], nullptr, 10)) : 20000000;
+        cout << "\n--- Benchmark ---\n";
+        benchmark(n, m);
+        benchmarkWindows(200000, 1000000, 150000, 500);
+    }
 }
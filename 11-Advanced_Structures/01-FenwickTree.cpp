@@ -1,39 +1,438 @@
 #include <iostream>
 #include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <stdexcept>
+#include <random>
+#include <chrono>
+#include <utility>
+#include <algorithm>
 using namespace std;
 
+/*
+ * Fenwick tree over any additive value type (int64_t by default, so large
+ * counters no longer overflow 32 bits). Indices are 0-based; bit[] is the
+ * usual 1-based implicit tree stored in one contiguous array.
+ */
+template <typename T = int64_t>
 class FenwickTree {
-    vector<int> bit;
+    vector<T> bit;
     int n;
 
+    // Adds each bit[i] into its Fenwick parent, turning plain values into
+    // the tree in one forward pass. Shared by the bulk constructor and
+    // large update batches.
+    static void accumulate(vector<T>& a, int n) {
+        for (int i = 1; i <= n; ++i) {
+            int parent = i + (i & -i);
+            if (parent <= n) a[parent] += a[i];
+        }
+    }
+
 public:
     FenwickTree(int size) : n(size) {
-        bit.assign(n + 1, 0);
+        bit.assign(n + 1, T());
     }
 
-    void update(int index, int val) {
+    // O(n) build from initial values instead of n calls to update().
+    FenwickTree(const vector<T>& values) : n(int(values.size())) {
+        bit.assign(n + 1, T());
+        for (int i = 0; i < n; ++i) bit[i + 1] = values[i];
+        accumulate(bit, n);
+    }
+
+    int size() const { return n; }
+
+    void update(int index, T val) {
         for (++index; index <= n; index += index & -index)
             bit[index] += val;
     }
 
-    int query(int index) {
-        int sum = 0;
+    // Applies many point updates at once. Small batches go one by one;
+    // once a batch costs more than a rebuild, the deltas are turned into a
+    // Fenwick tree of their own in O(n) and added element-wise.
+    void updateBatch(const vector<pair<int, T>>& updates) {
+        size_t logN = 1;
+        while ((size_t(1) << logN) < size_t(n) + 1) ++logN;
+        if (updates.size() * logN < size_t(n)) {
+            for (const auto& [index, val] : updates) update(index, val);
+            return;
+        }
+        vector<T> delta(n + 1, T());
+        for (const auto& [index, val] : updates) delta[index + 1] += val;
+        accumulate(delta, n);
+        for (int i = 1; i <= n; ++i) bit[i] += delta[i];
+    }
+
+    T query(int index) const {
+        T sum = T();
         for (++index; index > 0; index -= index & -index)
             sum += bit[index];
         return sum;
     }
 
-    int rangeQuery(int l, int r) {
+    T rangeQuery(int l, int r) const {
+        return query(r) - query(l - 1);
+    }
+
+    // Smallest index whose prefix sum reaches target, or size() if none.
+    // Needs non-negative values (counts, weights); one top-down descent
+    // over powers of two, O(log n), for weighted sampling and percentiles.
+    int lower_bound(T target) const {
+        int pos = 0;
+        int step = 1;
+        // Bounds are written as differences from n so nothing overflows near INT_MAX
+        while (step <= n / 2) step *= 2;
+        for (; step > 0; step /= 2) {
+            // Both possible next probes are known now; fetch them while
+            // this comparison waits on memory.
+            int half = step / 2;
+            if (step + half <= n - pos) __builtin_prefetch(&bit[pos + step + half]);
+            if (half <= n - pos) __builtin_prefetch(&bit[pos + half]);
+            if (step <= n - pos && bit[pos + step] < target) {
+                pos += step;
+                target -= bit[pos];
+            }
+        }
+        return pos;
+    }
+};
+
+/*
+ * Range update, range query: the dual-BIT technique. Adding v to [l, r]
+ * is stored as slopes in b1 and offsets in b2 so that
+ *   prefix(i) = b1.query(i) * (i + 1) - b2.query(i),
+ * which makes both operations O(log n) with two ordinary Fenwick trees.
+ */
+template <typename T = int64_t>
+class RangeFenwickTree {
+    FenwickTree<T> b1, b2;
+
+public:
+    RangeFenwickTree(int size) : b1(size), b2(size) {}
+
+    int size() const { return b1.size(); }
+
+    void rangeAdd(int l, int r, T val) {
+        b1.update(l, val);
+        b1.update(r + 1, -val);
+        b2.update(l, val * T(l));
+        b2.update(r + 1, -val * T(r + 1));
+    }
+
+    T query(int index) const {
+        return b1.query(index) * T(index + 1) - b2.query(index);
+    }
+
+    T rangeQuery(int l, int r) const {
         return query(r) - query(l - 1);
     }
 };
 
-int main() {
-    FenwickTree ft(10);
+/*
+ * 2D Fenwick tree: update(r, c) and sums over [0..r] x [0..c] in
+ * O(log R * log C), stored row-major in one flat array. Each inner column
+ * chain stays within one row. The row stride is padded to whole cache
+ * lines but never to a multiple of 4 KiB, so the rows an outer chain
+ * visits don't all compete for the same cache sets.
+ */
+template <typename T = int64_t>
+class FenwickTree2D {
+    vector<T> cells;
+    int rows, cols;
+    size_t stride;
+
+public:
+    FenwickTree2D(int rows, int cols) : rows(rows), cols(cols) {
+        size_t line = 64 / sizeof(T) ? 64 / sizeof(T) : 1;
+        stride = (size_t(cols) + line) / line * line;
+        if ((stride * sizeof(T)) % 4096 == 0) stride += line;
+        cells.assign((size_t(rows) + 1) * stride, T());
+    }
+
+    void update(int r, int c, T val) {
+        for (int i = r + 1; i <= rows; i += i & -i) {
+            T* row = &cells[size_t(i) * stride];
+            for (int j = c + 1; j <= cols; j += j & -j) row[j] += val;
+        }
+    }
+
+    T query(int r, int c) const {
+        T sum = T();
+        for (int i = r + 1; i > 0; i -= i & -i) {
+            const T* row = &cells[size_t(i) * stride];
+            for (int j = c + 1; j > 0; j -= j & -j) sum += row[j];
+        }
+        return sum;
+    }
+
+    // Sum over the rectangle [r1..r2] x [c1..c2].
+    T rangeQuery(int r1, int c1, int r2, int c2) const {
+        return query(r2, c2) - query(r1 - 1, c2) - query(r2, c1 - 1) + query(r1 - 1, c1 - 1);
+    }
+};
+
+/*
+ * Fenwick tree over sparse keys (timestamps, tile ids, user ids) that are
+ * known up front. The keys are sorted and deduplicated once, and each
+ * operation maps its key to a dense index by binary search.
+ */
+template <typename Key, typename T = int64_t>
+class CompressedFenwickTree {
+    vector<Key> keys;
+    FenwickTree<T> tree;
+
+    static vector<Key> compress(vector<Key> k) {
+        sort(k.begin(), k.end());
+        k.erase(unique(k.begin(), k.end()), k.end());
+        return k;
+    }
+
+public:
+    CompressedFenwickTree(const vector<Key>& universe) : keys(compress(universe)), tree(int(keys.size())) {}
+
+    // The key must be one of those given to the constructor; others throw
+    // instead of being credited to a neighbouring key.
+    void update(const Key& key, T val) {
+        auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        if (it == keys.end() || *it != key) throw out_of_range("Key is not in the tree's universe.");
+        tree.update(int(it - keys.begin()), val);
+    }
+
+    // Sum over every key <= key; any key works here, not just known ones.
+    T query(const Key& key) const {
+        return tree.query(int(upper_bound(keys.begin(), keys.end(), key) - keys.begin()) - 1);
+    }
+
+    // Sum over keys in [lo, hi].
+    T rangeQuery(const Key& lo, const Key& hi) const {
+        if (hi < lo) return T();
+        return query(hi) - tree.query(int(std::lower_bound(keys.begin(), keys.end(), lo) - keys.begin()) - 1);
+    }
+};
+
+// ---------- Benchmark ----------
+
+template <typename F>
+double seconds(F&& f) {
+    auto t0 = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+void benchmark(int n, int ops) {
+    mt19937_64 rng(13);
+    vector<int64_t> values(n);
+    for (auto& v : values) v = int64_t(rng() % 1000);
+
+    cout << "  n = " << n << ", " << ops << " operations each\n";
+    FenwickTree<int64_t>* incremental = nullptr;
+    double slowBuild = seconds([&] {
+        incremental = new FenwickTree<int64_t>(n);
+        for (int i = 0; i < n; ++i) incremental->update(i, values[i]);
+    });
+    FenwickTree<int64_t>* bulk = nullptr;
+    double fastBuild = seconds([&] { bulk = new FenwickTree<int64_t>(values); });
+    bool same = incremental->query(n - 1) == bulk->query(n - 1) && incremental->query(n / 3) == bulk->query(n / 3);
+    delete incremental;
+    vector<int64_t>().swap(values);
+    cout << "    build: n x update " << slowBuild << " s, O(n) constructor " << fastBuild << " s"
+         << (same ? "" : "  MISMATCH") << "\n";
+    cout << "    total sum " << bulk->query(n - 1) << " (overflows 32-bit int)\n";
+
+    vector<pair<int, int64_t>> batch(ops);
+    for (auto& u : batch) u = {int(rng() % n), int64_t(rng() % 100)};
+    double single = seconds([&] { for (const auto& [i, v] : batch) bulk->update(i, v); });
+    double batched = seconds([&] { bulk->updateBatch(batch); });
+
+    int64_t total = bulk->query(n - 1), checksum = 0;
+    double prefix = seconds([&] {
+        for (int k = 0; k < ops; ++k) checksum += bulk->query(int(rng() % n));
+    });
+    int misses = 0;
+    for (int k = 0; k < 1000; ++k) {
+        int64_t target = int64_t(rng() % uint64_t(total)) + 1;
+        int idx = bulk->lower_bound(target);
+        misses += !(bulk->query(idx) >= target && (idx == 0 || bulk->query(idx - 1) < target));
+    }
+    double search = seconds([&] {
+        for (int k = 0; k < ops; ++k) checksum += bulk->lower_bound(int64_t(rng() % uint64_t(total)) + 1);
+    });
+
+    auto rate = [&](double s) { return ops / s / 1e6; };
+    cout << "    point updates:     " << rate(single) << " M/s one by one, " << rate(batched)
+         << " M/s as one batch\n"
+         << "    prefix queries:    " << rate(prefix) << " M/s\n"
+         << "    lower_bound:       " << rate(search) << " M/s (" << (misses ? "MISMATCH" : "sampled results correct")
+         << ")\n"
+         << "    (checksum " << checksum % 1000 << ")\n";
+    delete bulk;
+}
+
+// Rounds of k updates followed by k queries: the naive side applies the
+// updates to a plain array and recomputes its prefix sums before querying.
+void printRates(const string& name, long long ops, double naiveSec, double fenwickSec, bool agree) {
+    cout << "    " << name << ": naive recompute " << ops / naiveSec / 1e6 << " M ops/s, Fenwick "
+         << ops / fenwickSec / 1e6 << " M ops/s (" << naiveSec / fenwickSec << "x)"
+         << (agree ? "" : "  MISMATCH") << "\n";
+}
+
+void benchmarkVariants(int rounds, int k) {
+    mt19937_64 rng(14);
+    long long ops = 2LL * rounds * k;
+    cout << "  " << rounds << " rounds of " << k << " updates + " << k << " queries\n";
+
+    // 2D heatmap: point increments, rectangle sums.
+    {
+        const int R = 4096, C = 4096;
+        struct Op { int r1, c1, r2, c2; int64_t v; };
+        vector<Op> work(size_t(rounds) * k);
+        for (auto& o : work) {
+            int a = int(rng() % R), b = int(rng() % R), c = int(rng() % C), d = int(rng() % C);
+            o = {min(a, b), min(c, d), max(a, b), max(c, d), int64_t(rng() % 100)};
+        }
+        int64_t naiveSum = 0, fenwickSum = 0;
+        double naive = seconds([&] {
+            vector<int64_t> grid(size_t(R) * C, 0), pre(size_t(R + 1) * (C + 1), 0);
+            for (int round = 0; round < rounds; ++round) {
+                const Op* batch = &work[size_t(round) * k];
+                for (int q = 0; q < k; ++q) grid[size_t(batch[q].r1) * C + batch[q].c1] += batch[q].v;
+                for (int r = 0; r < R; ++r)
+                    for (int c = 0; c < C; ++c)
+                        pre[size_t(r + 1) * (C + 1) + c + 1] = grid[size_t(r) * C + c] + pre[size_t(r) * (C + 1) + c + 1] +
+                                                               pre[size_t(r + 1) * (C + 1) + c] - pre[size_t(r) * (C + 1) + c];
+                auto P = [&](int r, int c) { return pre[size_t(r) * (C + 1) + c]; };
+                for (int q = 0; q < k; ++q) {
+                    const Op& o = batch[q];
+                    naiveSum += P(o.r2 + 1, o.c2 + 1) - P(o.r1, o.c2 + 1) - P(o.r2 + 1, o.c1) + P(o.r1, o.c1);
+                }
+            }
+        });
+        auto run = [&](auto& tree, int64_t& sum) {
+            for (int round = 0; round < rounds; ++round) {
+                const Op* batch = &work[size_t(round) * k];
+                for (int q = 0; q < k; ++q) tree.update(batch[q].r1, batch[q].c1, batch[q].v);
+                for (int q = 0; q < k; ++q) sum += tree.rangeQuery(batch[q].r1, batch[q].c1, batch[q].r2, batch[q].c2);
+            }
+        };
+        FenwickTree2D<int64_t> tree(R, C);
+        double fenwick = seconds([&] { run(tree, fenwickSum); });
+        printRates("2D 4096x4096     ", ops, naive, fenwick, naiveSum == fenwickSum);
+    }
+
+    // Range add / range sum over a 1D array.
+    {
+        const int n = 10000000;
+        struct Op { int l, r; int64_t v; };
+        vector<Op> work(size_t(rounds) * k);
+        for (auto& o : work) {
+            int a = int(rng() % n), b = int(rng() % n);
+            o = {min(a, b), max(a, b), int64_t(rng() % 100)};
+        }
+        int64_t naiveSum = 0, fenwickSum = 0;
+        double naive = seconds([&] {
+            vector<int64_t> diff(n + 1, 0), pre(n + 1, 0);
+            for (int round = 0; round < rounds; ++round) {
+                const Op* batch = &work[size_t(round) * k];
+                for (int q = 0; q < k; ++q) {
+                    diff[batch[q].l] += batch[q].v;
+                    diff[batch[q].r + 1] -= batch[q].v;
+                }
+                int64_t value = 0;
+                for (int i = 0; i < n; ++i) {
+                    value += diff[i];
+                    pre[i + 1] = pre[i] + value;
+                }
+                for (int q = 0; q < k; ++q) naiveSum += pre[batch[q].r + 1] - pre[batch[q].l];
+            }
+        });
+        RangeFenwickTree<int64_t> tree(n);
+        double fenwick = seconds([&] {
+            for (int round = 0; round < rounds; ++round) {
+                const Op* batch = &work[size_t(round) * k];
+                for (int q = 0; q < k; ++q) tree.rangeAdd(batch[q].l, batch[q].r, batch[q].v);
+                for (int q = 0; q < k; ++q) fenwickSum += tree.rangeQuery(batch[q].l, batch[q].r);
+            }
+        });
+        printRates("range add/sum 1e7", ops, naive, fenwick, naiveSum == fenwickSum);
+    }
+
+    // Sparse 64-bit keys: one million distinct ids spread over the full range.
+    {
+        vector<uint64_t> universe(1000000);
+        for (auto& key : universe) key = rng();
+        struct Op { uint64_t key, lo, hi; int64_t v; };
+        vector<Op> work(size_t(rounds) * k);
+        for (auto& o : work) {
+            uint64_t a = rng(), b = rng();
+            o = {universe[rng() % universe.size()], min(a, b), max(a, b), int64_t(rng() % 100)};
+        }
+        int64_t naiveSum = 0, fenwickSum = 0;
+        double naive = seconds([&] {
+            vector<uint64_t> keys = universe;
+            sort(keys.begin(), keys.end());
+            keys.erase(unique(keys.begin(), keys.end()), keys.end());
+            vector<int64_t> values(keys.size(), 0), pre(keys.size() + 1, 0);
+            auto rank = [&](uint64_t key) { return size_t(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin()); };
+            for (int round = 0; round < rounds; ++round) {
+                const Op* batch = &work[size_t(round) * k];
+                for (int q = 0; q < k; ++q) values[rank(batch[q].key)] += batch[q].v;
+                for (size_t i = 0; i < values.size(); ++i) pre[i + 1] = pre[i] + values[i];
+                for (int q = 0; q < k; ++q) {
+                    size_t hi = size_t(upper_bound(keys.begin(), keys.end(), batch[q].hi) - keys.begin());
+                    naiveSum += pre[hi] - pre[rank(batch[q].lo)];
+                }
+            }
+        });
+        CompressedFenwickTree<uint64_t, int64_t> tree(universe);
+        double fenwick = seconds([&] {
+            for (int round = 0; round < rounds; ++round) {
+                const Op* batch = &work[size_t(round) * k];
+                for (int q = 0; q < k; ++q) tree.update(batch[q].key, batch[q].v);
+                for (int q = 0; q < k; ++q) fenwickSum += tree.rangeQuery(batch[q].lo, batch[q].hi);
+            }
+        });
+        printRates("sparse 64-bit ids", ops, naive, fenwick, naiveSum == fenwickSum);
+    }
+}
+
+int main(int argc, char** argv) {
+    FenwickTree<int> ft(10);
     ft.update(2, 5);
     ft.update(4, 3);
     ft.update(6, 7);
 
     cout << "Sum[0..6]: " << ft.query(6) << endl;
     cout << "Sum[2..6]: " << ft.rangeQuery(2, 6) << endl;
+
+    // Weighted sampling: index i is picked with probability weight[i] / total.
+    FenwickTree<int64_t> weights(vector<int64_t>{5, 0, 10, 3, 2});
+    cout << "Weight 1..5 lands on index " << weights.lower_bound(1) << ", 6..15 on "
+         << weights.lower_bound(6) << ", 16..18 on " << weights.lower_bound(16) << endl;
+
+    RangeFenwickTree<int64_t> ranges(10);
+    ranges.rangeAdd(2, 5, 4);
+    ranges.rangeAdd(4, 8, 1);
+    cout << "Range adds [2..5]+4, [4..8]+1 -> Sum[3..6]: " << ranges.rangeQuery(3, 6) << endl;
+
+    FenwickTree2D<int64_t> heat(100, 100);
+    heat.update(10, 20, 3);
+    heat.update(50, 50, 5);
+    heat.update(99, 0, 7);
+    cout << "Heatmap sum over [0..60]x[0..60]: " << heat.rangeQuery(0, 0, 60, 60) << endl;
+
+    CompressedFenwickTree<uint64_t> sparse({1700000000000ULL, 1700000000500ULL, 1700000900000ULL});
+    sparse.update(1700000000000ULL, 2);
+    sparse.update(1700000900000ULL, 9);
+    cout << "Sparse keys <= 1700000000999: " << sparse.query(1700000000999ULL) << endl;
+
+    // Usage: 01-FenwickTree --benchmark [n] [operations]
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        int n = argc > 2 ? atoi(argv[2]) : 100000000;
+        int ops = argc > 3 ? atoi(argv[3]) : 10000000;
+        cout << "\n--- Benchmark ---\n";
+        benchmark(n, ops);
+        benchmarkVariants(20, 1000);
+    }
 }
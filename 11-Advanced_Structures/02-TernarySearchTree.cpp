@@ -1,50 +1,281 @@
 #include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <utility>
 using namespace std;
 
+// Arena node: children are 32-bit indices into the pool, 0 means none.
 struct Node {
     char c;
     bool isEnd = false;
-    Node *left = nullptr, *eq = nullptr, *right = nullptr;
+    uint32_t left = 0, eq = 0, right = 0;
 };
 
 class TernarySearchTree {
-    Node* root = nullptr;
+    vector<Node> pool{Node{}};  // slot 0 is the null sentinel
+    uint32_t root = 0;
+    size_t words = 0;
 
-    Node* insert(Node* node, const string& word, int pos) {
-        if (pos >= word.size()) return node;
+    uint32_t newNode(char c) {
+        pool.push_back(Node{c});
+        return uint32_t(pool.size() - 1);
+    }
+
+    // Inserts the median first, then each half, so every left/right chain
+    // is split roughly evenly by word count.
+    void insertBalanced(const vector<string>& sorted, size_t lo, size_t hi) {
+        if (lo >= hi) return;
+        size_t mid = lo + (hi - lo) / 2;
+        insert(sorted[mid]);
+        insertBalanced(sorted, lo, mid);
+        insertBalanced(sorted, mid + 1, hi);
+    }
+
+    // In-order walk of the subtree at `node`, emitting cur + path in sorted order.
+    void collect(uint32_t node, string& cur, vector<string>& out, size_t limit) const {
+        if (!node || out.size() >= limit) return;
+        const Node& n = pool[node];
+        collect(n.left, cur, out, limit);
+        if (out.size() >= limit) return;
+        cur.push_back(n.c);
+        if (n.isEnd) out.push_back(cur);
+        collect(n.eq, cur, out, limit);
+        cur.pop_back();
+        collect(n.right, cur, out, limit);
+    }
+
+    struct WildcardQuery {
+        const vector<Node>& pool;
+        const string& pattern;
+        vector<bool> restIsStars;  // restIsStars[i]: pattern[i..] is all '*'
+        string cur;
+        vector<string> out;
+
+        // Node `node` consumed pattern[p]; report if the word may end here.
+        void visit(uint32_t node, size_t p, size_t next) {
+            const Node& n = pool[node];
+            cur.push_back(n.c);
+            if (n.isEnd && restIsStars[p + 1]) out.push_back(cur);
+            if (next < pattern.size()) level(n.eq, next);
+            cur.pop_back();
+        }
+
+        // '*' at p consumes the character at every node of this level and stays active.
+        void starConsume(uint32_t node, size_t p) {
+            if (!node) return;
+            starConsume(pool[node].left, p);
+            visit(node, p, p);
+            starConsume(pool[node].right, p);
+        }
+
+        // Matches pattern[p..] against the level (left/right siblings) rooted at `node`.
+        void level(uint32_t node, size_t p) {
+            if (!node) return;
+            char pc = pattern[p];
+            if (pc == '*') {
+                if (p + 1 < pattern.size()) level(node, p + 1);
+                starConsume(node, p);
+            } else if (pc == '?') {
+                level(pool[node].left, p);
+                visit(node, p, p + 1);
+                level(pool[node].right, p);
+            } else {
+                while (node && pool[node].c != pc) node = pc < pool[node].c ? pool[node].left : pool[node].right;
+                if (node) visit(node, p, p + 1);
+            }
+        }
+    };
+
+    void hamming(uint32_t node, const string& word, size_t pos, int budget, int maxDistance, string& cur,
+                 vector<pair<string, int>>& out) const {
+        if (!node) return;
+        const Node& n = pool[node];
         char ch = word[pos];
-        if (!node) node = new Node{ch};
-        if (ch < node->c) node->left = insert(node->left, word, pos);
-        else if (ch > node->c) node->right = insert(node->right, word, pos);
-        else {
-            if (pos + 1 == word.size()) node->isEnd = true;
-            else node->eq = insert(node->eq, word, pos + 1);
+        if (budget > 0 || ch < n.c) hamming(n.left, word, pos, budget, maxDistance, cur, out);
+        int cost = ch != n.c;
+        if (cost <= budget) {
+            cur.push_back(n.c);
+            if (pos + 1 == word.size()) {
+                if (n.isEnd) out.emplace_back(cur, maxDistance - budget + cost);
+            } else {
+                hamming(n.eq, word, pos + 1, budget - cost, maxDistance, cur, out);
+            }
+            cur.pop_back();
         }
-        return node;
+        if (budget > 0 || ch > n.c) hamming(n.right, word, pos, budget, maxDistance, cur, out);
     }
 
-    bool search(Node* node, const string& word, int pos) {
-        if (!node) return false;
-        char ch = word[pos];
-        if (ch < node->c) return search(node->left, word, pos);
-        else if (ch > node->c) return search(node->right, word, pos);
-        else {
-            if (pos + 1 == word.size()) return node->isEnd;
-            return search(node->eq, word, pos + 1);
+    uint32_t findNode(const string& word) const {
+        uint32_t node = root;
+        size_t pos = 0;
+        while (node) {
+            const Node& n = pool[node];
+            char ch = word[pos];
+            if (ch < n.c) node = n.left;
+            else if (ch > n.c) node = n.right;
+            else if (pos + 1 == word.size()) return node;
+            else node = n.eq, pos++;
         }
+        return 0;
     }
 
 public:
+    TernarySearchTree() = default;
+
+    // Balanced bulk build. The input is sorted and deduplicated here if needed.
+    TernarySearchTree(vector<string> sortedWords) {
+        if (!is_sorted(sortedWords.begin(), sortedWords.end())) sort(sortedWords.begin(), sortedWords.end());
+        sortedWords.erase(unique(sortedWords.begin(), sortedWords.end()), sortedWords.end());
+        insertBalanced(sortedWords, 0, sortedWords.size());
+        pool.shrink_to_fit();
+    }
+
     void insert(const string& word) {
-        root = insert(root, word, 0);
+        if (word.empty()) return;
+        if (!root) root = newNode(word[0]);
+        uint32_t node = root;
+        size_t pos = 0;
+        while (true) {
+            char ch = word[pos];
+            if (ch < pool[node].c) {
+                if (!pool[node].left) {
+                    uint32_t k = newNode(ch);
+                    pool[node].left = k;
+                }
+                node = pool[node].left;
+            } else if (ch > pool[node].c) {
+                if (!pool[node].right) {
+                    uint32_t k = newNode(ch);
+                    pool[node].right = k;
+                }
+                node = pool[node].right;
+            } else if (pos + 1 == word.size()) {
+                if (!pool[node].isEnd) words++;
+                pool[node].isEnd = true;
+                return;
+            } else {
+                if (!pool[node].eq) {
+                    uint32_t k = newNode(word[pos + 1]);
+                    pool[node].eq = k;
+                }
+                node = pool[node].eq;
+                pos++;
+            }
+        }
     }
 
-    bool search(const string& word) {
-        return search(root, word, 0);
+    bool search(const string& word) const {
+        if (word.empty()) return false;
+        uint32_t node = findNode(word);
+        return node && pool[node].isEnd;
     }
+
+    // All words starting with `prefix`, in sorted order, at most `limit` of them.
+    vector<string> prefixSearch(const string& prefix, size_t limit = SIZE_MAX) const {
+        vector<string> out;
+        string cur = prefix;
+        if (prefix.empty()) {
+            collect(root, cur, out, limit);
+            return out;
+        }
+        uint32_t node = findNode(prefix);
+        if (!node || !limit) return out;
+        if (pool[node].isEnd) out.push_back(prefix);
+        collect(pool[node].eq, cur, out, limit);
+        return out;
+    }
+
+    // '?' matches any one character, '*' any run (including none). Sorted output.
+    vector<string> wildcardSearch(const string& pattern) const {
+        string p;
+        for (char ch : pattern)
+            if (ch != '*' || p.empty() || p.back() != '*') p.push_back(ch);
+        if (p.empty()) return {};
+        WildcardQuery q{pool, p, vector<bool>(p.size() + 1, true), {}, {}};
+        for (size_t i = p.size(); i-- > 0;) q.restIsStars[i] = p[i] == '*' && q.restIsStars[i + 1];
+        q.level(root, 0);
+        sort(q.out.begin(), q.out.end());
+        q.out.erase(unique(q.out.begin(), q.out.end()), q.out.end());
+        return q.out;
+    }
+
+    // Same-length words within `maxDistance` substitutions, closest first.
+    vector<pair<string, int>> nearNeighbors(const string& word, int maxDistance) const {
+        vector<pair<string, int>> out;
+        if (word.empty()) return out;
+        string cur;
+        hamming(root, word, 0, maxDistance, maxDistance, cur, out);
+        sort(out.begin(), out.end(), [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second < b.second : a.first < b.first;
+        });
+        return out;
+    }
+
+    size_t size() const { return words; }
+    size_t nodeCount() const { return pool.size() - 1; }
+    size_t bytes() const { return pool.capacity() * sizeof(Node); }
 };
 
-int main() {
+// ---------- Benchmark: sequential vs. balanced build ----------
+
+template <typename F>
+double seconds(F&& f) {
+    auto t0 = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+void benchmark(size_t count) {
+    mt19937_64 rng(16);
+    vector<string> dict(count);
+    for (auto& w : dict) {
+        w.resize(4 + rng() % 7);
+        for (auto& ch : w) ch = char('a' + rng() % 26);
+    }
+    sort(dict.begin(), dict.end());
+    dict.erase(unique(dict.begin(), dict.end()), dict.end());
+    vector<string> probes(dict);
+    shuffle(probes.begin(), probes.end(), rng);
+
+    TernarySearchTree sequential, balanced;
+    double seqBuild = seconds([&] {
+        for (const auto& w : dict) sequential.insert(w);
+    });
+    double balBuild = seconds([&] { balanced = TernarySearchTree(dict); });
+
+    auto lookups = [&](const TernarySearchTree& t) {
+        size_t found = 0;
+        double s = seconds([&] {
+            for (const auto& w : probes) found += t.search(w);
+        });
+        if (found != probes.size()) cout << "  MISSING WORDS\n";
+        return s * 1e9 / probes.size();
+    };
+
+    struct PointerNode {
+        char c;
+        bool isEnd;
+        PointerNode *left, *eq, *right;
+    };
+    cout << "  " << dict.size() << " words, " << balanced.nodeCount() << " nodes: arena " << balanced.bytes() / 1048576.0
+         << " MiB vs " << balanced.nodeCount() * sizeof(PointerNode) / 1048576.0
+         << " MiB for pointer nodes (before malloc overhead)\n";
+    cout << "  sorted insert:  build " << seqBuild * 1e3 << " ms, search " << lookups(sequential) << " ns\n";
+    cout << "  balanced build: build " << balBuild * 1e3 << " ms, search " << lookups(balanced) << " ns\n";
+
+    size_t suggestions = 0;
+    double near = seconds([&] {
+        for (size_t i = 0; i < 1000; i++) suggestions += balanced.nearNeighbors(probes[i], 1).size();
+    });
+    cout << "  nearNeighbors(d = 1): " << near * 1e3 << " us per query, " << suggestions / 1000.0
+         << " suggestions on average\n";
+}
+
+int main(int argc, char** argv) {
     TernarySearchTree tst;
     tst.insert("cat");
     tst.insert("car");
@@ -52,4 +283,23 @@ int main() {
 
     cout << "Searching 'car': " << (tst.search("car") ? "Found" : "Not Found") << endl;
     cout << "Searching 'cap': " << (tst.search("cap") ? "Found" : "Not Found") << endl;
+
+    TernarySearchTree dict({"bat", "bath", "cap", "car", "card", "care", "cart", "cat", "cater", "dog"});
+    auto print = [](const string& label, const vector<string>& words) {
+        cout << label << ":";
+        for (const auto& w : words) cout << " " << w;
+        cout << endl;
+    };
+    print("Prefix 'car'", dict.prefixSearch("car"));
+    print("Pattern 'ca?'", dict.wildcardSearch("ca?"));
+    print("Pattern 'c*t'", dict.wildcardSearch("c*t"));
+    cout << "Near 'cbt' (d <= 1):";
+    for (const auto& [w, d] : dict.nearNeighbors("cbt", 1)) cout << " " << w << "(" << d << ")";
+    cout << endl;
+
+    // Usage: 02-TernarySearchTree --benchmark
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        cout << "\n--- Benchmark ---\n";
+        benchmark(1000000);
+    }
 }
@@ -0,0 +1,361 @@
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <random>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <utility>
+using namespace std;
+
+// Pending update for a whole subtree: optionally assign a value, then add.
+template <typename T>
+struct RangeUpdate {
+    bool assign;
+    T set;
+    T add;
+
+    static RangeUpdate none() { return {false, T(), T()}; }
+    static RangeUpdate addBy(T v) { return {false, T(), v}; }
+    static RangeUpdate assignTo(T v) { return {true, v, T()}; }
+
+    bool empty() const { return !assign && add == T(); }
+
+    // `outer` happens after `inner`: an assign wipes out what came before.
+    static RangeUpdate compose(const RangeUpdate& outer, const RangeUpdate& inner) {
+        if (outer.assign) return outer;
+        return {inner.assign, inner.set, inner.add + outer.add};
+    }
+};
+
+// Monoids: identity, combine, and how a RangeUpdate changes a node that
+// covers `length` elements.
+template <typename T>
+struct SumOp {
+    using Value = T;
+    using Lazy = RangeUpdate<T>;
+    static T identity() { return T(); }
+    static T combine(const T& a, const T& b) { return a + b; }
+    static T apply(const Lazy& f, const T& v, int length) {
+        return (f.assign ? f.set * T(length) : v) + f.add * T(length);
+    }
+};
+
+template <typename T>
+struct MinOp {
+    using Value = T;
+    using Lazy = RangeUpdate<T>;
+    static T identity() { return numeric_limits<T>::max(); }
+    static T combine(const T& a, const T& b) { return min(a, b); }
+    static T apply(const Lazy& f, const T& v, int) { return (f.assign ? f.set : v) + f.add; }
+};
+
+template <typename T>
+struct MaxOp {
+    using Value = T;
+    using Lazy = RangeUpdate<T>;
+    static T identity() { return numeric_limits<T>::lowest(); }
+    static T combine(const T& a, const T& b) { return max(a, b); }
+    static T apply(const Lazy& f, const T& v, int) { return (f.assign ? f.set : v) + f.add; }
+};
+
+/*
+ * Iterative lazy-propagation segment tree over a monoid.
+ *
+ * Layout: the usual implicit heap in flat arrays, with the size rounded up
+ * to a power of two. Node k's children are 2k and 2k+1 and leaves start at
+ * `size`. Values and pending updates live in separate arrays, so a query
+ * that needs no pushes touches only value cache lines.
+ *
+ * Operations walk bottom-up from the two leaf boundaries, as in the
+ * classic non-recursive segment tree. Tags are pushed down only along the
+ * two boundary paths before touching a range, and parents are recomputed
+ * only along those paths afterwards. Everything is O(log n) with no
+ * recursion. Intervals are inclusive [l, r], like FenwickTree.
+ */
+template <typename Op>
+class LazySegmentTree {
+    using Value = typename Op::Value;
+    using Lazy = typename Op::Lazy;
+
+    int n, size, log;
+    vector<Value> d;  // 2 * size node values
+    vector<Lazy> lz;  // size pending updates, internal nodes only
+    bool pending = false;
+
+    int length(int k) const { return size >> (31 - __builtin_clz(unsigned(k))); }
+
+    void pull(int k) { d[k] = Op::combine(d[2 * k], d[2 * k + 1]); }
+
+    void applyNode(int k, const Lazy& f) {
+        d[k] = Op::apply(f, d[k], length(k));
+        if (k < size) lz[k] = Lazy::compose(f, lz[k]);
+    }
+
+    void push(int k) {
+        if (lz[k].empty()) return;
+        applyNode(2 * k, lz[k]);
+        applyNode(2 * k + 1, lz[k]);
+        lz[k] = Lazy::none();
+    }
+
+    // Pushes tags on the paths above the half-open leaf range [l, r).
+    void pushBoundaries(int l, int r) {
+        if (!pending) return;
+        for (int i = log; i >= 1; i--) {
+            if (((l >> i) << i) != l) push(l >> i);
+            if (((r >> i) << i) != r) push((r - 1) >> i);
+        }
+    }
+
+public:
+    LazySegmentTree(int n) : LazySegmentTree(vector<Value>(n, Op::identity())) {}
+
+    // O(n) build from initial values.
+    LazySegmentTree(const vector<Value>& values) : n(int(values.size())), size(1), log(0) {
+        while (size < n) size <<= 1, log++;
+        d.assign(2 * size, Op::identity());
+        lz.assign(size, Lazy::none());
+        for (int i = 0; i < n; i++) d[size + i] = values[i];
+        for (int k = size - 1; k >= 1; k--) pull(k);
+    }
+
+    int length() const { return n; }
+
+    void set(int index, const Value& v) {
+        int p = index + size;
+        for (int i = log; i >= 1 && pending; i--) push(p >> i);
+        d[p] = v;
+        for (int i = 1; i <= log; i++) pull(p >> i);
+    }
+
+    // Not const: pending tags on the boundary paths are pushed on the way.
+    Value query(int l, int r) {
+        if (l > r) return Op::identity();
+        l += size;
+        r += size + 1;
+        pushBoundaries(l, r);
+        Value left = Op::identity(), right = Op::identity();
+        while (l < r) {
+            if (l & 1) left = Op::combine(left, d[l++]);
+            if (r & 1) right = Op::combine(d[--r], right);
+            l >>= 1;
+            r >>= 1;
+        }
+        return Op::combine(left, right);
+    }
+
+    Value queryAll() const { return d[1]; }
+
+    void apply(int l, int r, const Lazy& f) {
+        if (l > r) return;
+        l += size;
+        r += size + 1;
+        pushBoundaries(l, r);
+        pending = true;
+        for (int a = l, b = r; a < b; a >>= 1, b >>= 1) {
+            if (a & 1) applyNode(a++, f);
+            if (b & 1) applyNode(--b, f);
+        }
+        for (int i = 1; i <= log; i++) {
+            if (((l >> i) << i) != l) pull(l >> i);
+            if (((r >> i) << i) != r) pull((r - 1) >> i);
+        }
+    }
+
+    void rangeAdd(int l, int r, const Value& v) { apply(l, r, Lazy::addBy(v)); }
+    void rangeAssign(int l, int r, const Value& v) { apply(l, r, Lazy::assignTo(v)); }
+
+    // Pushes every pending tag to the leaves in one top-down O(n) pass.
+    // Afterwards queries are pure reads until the next range update.
+    void flush() {
+        if (!pending) return;
+        for (int k = 1; k < size; k++) push(k);
+        pending = false;
+    }
+
+    // Answers many [l, r] queries. When the batch would push more tags
+    // than a full flush, it flushes first so the queries skip pushing.
+    vector<Value> queryBatch(const vector<pair<int, int>>& ranges) {
+        if (pending && ranges.size() * size_t(log) * 2 > size_t(size)) flush();
+        vector<Value> out;
+        out.reserve(ranges.size());
+        for (const auto& [l, r] : ranges) out.push_back(query(l, r));
+        return out;
+    }
+};
+
+// Minimal copies of the Fenwick trees from 01-FenwickTree.cpp, kept here
+// as the baseline for the sum workloads both structures support.
+template <typename T>
+class FenwickTree {
+    vector<T> bit;
+    int n;
+
+public:
+    FenwickTree(const vector<T>& values) : bit(values.size() + 1, T()), n(int(values.size())) {
+        for (int i = 0; i < n; ++i) bit[i + 1] = values[i];
+        for (int i = 1; i <= n; ++i)
+            if (i + (i & -i) <= n) bit[i + (i & -i)] += bit[i];
+    }
+
+    void update(int index, T val) {
+        for (++index; index <= n; index += index & -index) bit[index] += val;
+    }
+
+    T query(int index) const {
+        T sum = T();
+        for (++index; index > 0; index -= index & -index) sum += bit[index];
+        return sum;
+    }
+
+    T rangeQuery(int l, int r) const { return query(r) - query(l - 1); }
+};
+
+template <typename T>
+class RangeFenwickTree {
+    FenwickTree<T> b1, b2;
+
+public:
+    RangeFenwickTree(int size) : b1(vector<T>(size)), b2(vector<T>(size)) {}
+
+    void rangeAdd(int l, int r, T val) {
+        b1.update(l, val);
+        b1.update(r + 1, -val);
+        b2.update(l, val * T(l));
+        b2.update(r + 1, -val * T(r + 1));
+    }
+
+    T query(int index) const { return b1.query(index) * T(index + 1) - b2.query(index); }
+    T rangeQuery(int l, int r) const { return query(r) - query(l - 1); }
+};
+
+// ---------- Benchmark: segment tree vs. Fenwick tree on sum workloads ----------
+
+template <typename F>
+double seconds(F&& f) {
+    auto t0 = chrono::steady_clock::now();
+    f();
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+void benchmark(int n, int ops) {
+    mt19937_64 rng(15);
+    vector<int64_t> values(n);
+    for (auto& v : values) v = int64_t(rng() % 1000);
+    vector<pair<int, int>> ranges(ops);
+    for (auto& [l, r] : ranges) {
+        l = int(rng() % n);
+        r = int(rng() % n);
+        if (l > r) swap(l, r);
+    }
+    vector<int64_t> deltas(ops);
+    for (auto& v : deltas) v = int64_t(rng() % 100);
+    auto rate = [&](double s) { return 2.0 * ops / s / 1e6; };
+    cout << "  n = " << n << ", " << ops << " updates + " << ops << " queries per workload\n";
+
+    // Point add + range sum: both structures' home turf.
+    {
+        int64_t a = 0, b = 0;
+        FenwickTree<int64_t> fenwick(values);
+        LazySegmentTree<SumOp<int64_t>> seg(values);
+        double fw = seconds([&] {
+            for (int k = 0; k < ops; ++k) {
+                fenwick.update(ranges[k].first, deltas[k]);
+                a += fenwick.rangeQuery(ranges[k].first, ranges[k].second);
+            }
+        });
+        double st = seconds([&] {
+            for (int k = 0; k < ops; ++k) {
+                seg.rangeAdd(ranges[k].first, ranges[k].first, deltas[k]);
+                b += seg.query(ranges[k].first, ranges[k].second);
+            }
+        });
+        cout << "    point add + range sum: Fenwick " << rate(fw) << " M ops/s, segment tree " << rate(st)
+             << " M ops/s" << (a == b ? "" : "  MISMATCH") << "\n";
+    }
+
+    // Range add + range sum: dual-BIT Fenwick against lazy propagation.
+    {
+        int64_t a = 0, b = 0;
+        RangeFenwickTree<int64_t> fenwick(n);
+        LazySegmentTree<SumOp<int64_t>> seg(n);
+        double fw = seconds([&] {
+            for (int k = 0; k < ops; ++k) {
+                fenwick.rangeAdd(ranges[k].first, ranges[k].second, deltas[k]);
+                a += fenwick.rangeQuery(ranges[(k * 7) % ops].first, ranges[(k * 7) % ops].second);
+            }
+        });
+        double st = seconds([&] {
+            for (int k = 0; k < ops; ++k) {
+                seg.rangeAdd(ranges[k].first, ranges[k].second, deltas[k]);
+                b += seg.query(ranges[(k * 7) % ops].first, ranges[(k * 7) % ops].second);
+            }
+        });
+        cout << "    range add + range sum: Fenwick " << rate(fw) << " M ops/s, segment tree " << rate(st)
+             << " M ops/s" << (a == b ? "" : "  MISMATCH") << "\n";
+
+        // Batched reads after a burst of range updates.
+        double single = seconds([&] {
+            int64_t s = 0;
+            for (const auto& [l, r] : ranges) s += seg.query(l, r);
+            a = s;
+        });
+        double batched = seconds([&] {
+            int64_t s = 0;
+            for (int64_t v : seg.queryBatch(ranges)) s += v;
+            b = s;
+        });
+        cout << "    " << ops << " queries after updates: one by one " << ops / single / 1e6 << " M/s, queryBatch "
+             << ops / batched / 1e6 << " M/s" << (a == b ? "" : "  MISMATCH") << "\n";
+    }
+
+    // What Fenwick cannot do: range assign with range min/max.
+    {
+        LazySegmentTree<MinOp<int64_t>> lo(values);
+        LazySegmentTree<MaxOp<int64_t>> hi(values);
+        int64_t spread = 0;
+        double st = seconds([&] {
+            for (int k = 0; k < ops; ++k) {
+                const auto& [l, r] = ranges[k];
+                if (k % 2) {
+                    lo.rangeAssign(l, r, deltas[k]);
+                    hi.rangeAssign(l, r, deltas[k]);
+                } else {
+                    lo.rangeAdd(l, r, deltas[k]);
+                    hi.rangeAdd(l, r, deltas[k]);
+                }
+                const auto& [ql, qr] = ranges[(k * 7) % ops];
+                spread += hi.query(ql, qr) - lo.query(ql, qr);
+            }
+        });
+        cout << "    range assign/add + range min & max: segment tree " << 3.0 * ops / st / 1e6
+             << " M ops/s (no Fenwick equivalent; checksum " << spread % 1000 << ")\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    LazySegmentTree<SumOp<int64_t>> sums(vector<int64_t>{5, 3, 8, 6, 1, 4});
+    LazySegmentTree<MinOp<int64_t>> mins(vector<int64_t>{5, 3, 8, 6, 1, 4});
+    cout << "Sum[1..4]: " << sums.query(1, 4) << ", Min[0..3]: " << mins.query(0, 3) << endl;
+
+    sums.rangeAdd(0, 2, 10);
+    mins.rangeAdd(0, 2, 10);
+    cout << "After adding 10 to [0..2] -> Sum[1..4]: " << sums.query(1, 4) << ", Min[0..3]: " << mins.query(0, 3)
+         << endl;
+
+    sums.rangeAssign(2, 5, 7);
+    mins.rangeAssign(2, 5, 7);
+    cout << "After assigning 7 to [2..5] -> Sum[0..5]: " << sums.query(0, 5) << ", Min[0..5]: " << mins.query(0, 5)
+         << endl;
+
+    // Usage: 03-SegmentTree --benchmark [n] [operations]
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        int n = argc > 2 ? atoi(argv[2]) : 10000000;
+        int ops = argc > 3 ? atoi(argv[3]) : 2000000;
+        cout << "\n--- Benchmark ---\n";
+        benchmark(n, ops);
+    }
+}